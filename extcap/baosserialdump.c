@@ -0,0 +1,631 @@
+/* baosserialdump.c
+ *
+ * Extcap capturing serial BAOS from an RS-232 line
+ * By Adam Rigely <adamrigely@pm.me>
+ *
+ * Reads a serial (or pseudo terminal) device, delimits FT 1.2 frames
+ * and single character acknowledgements as they arrive and writes
+ * every frame as an exported PDU for the "baos_ft12" dissector of the
+ * BAOS plugin into a pcapng stream. Build it with:
+ *
+ *   cc -O2 -I../plugins/epan/baos -o baosserialdump baosserialdump.c \
+ *      ../plugins/epan/baos/ft12.c
+ *
+ * and copy it into the extcap folder listed in "About Wireshark".
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ */
+
+#define _DEFAULT_SOURCE
+
+// Imports
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ft12.h"
+
+#define BAOSSERIALDUMP_VERSION "1.0"
+#define BAOSSERIALDUMP_INTERFACE "baosserial"
+
+// Exported PDUs as defined by epan/exported_pdu.h
+#define LINKTYPE_WIRESHARK_UPPER_PDU 252
+#define EXP_PDU_TAG_END_OF_OPT 0
+#define EXP_PDU_TAG_DISSECTOR_NAME 12
+#define BAOS_FT12_DISSECTOR_NAME "baos_ft12"
+
+// pcapng blocks and options
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_END_OF_OPT 0
+#define PCAPNG_OPT_IF_TSRESOL 9
+
+#define NSEC_PER_SEC UINT64_C(1000000000)
+
+// FT 1.2 characters have a start bit, 8 data bits,
+// an even parity bit and a stop bit
+#define FT12_BITS_PER_CHAR 11
+
+// Frames still incomplete after the line has been idle this long
+// are written as they are, USB serial adapters may hand over a
+// frame in pieces some milliseconds apart
+#define DEFAULT_FRAME_TIMEOUT_MS 100
+
+// Line speeds of the serial port in bits per second, matching the
+// codes of the BAUDRATE server item (enum BAUDRATES in packet-baos.h)
+enum SERIAL_BAUD_RATES
+{
+	BAUD_19200_BPS  = 19200,
+	BAUD_115200_BPS = 115200
+};
+
+enum FT12_DELIMITER_STATES
+{
+	FT12_HUNT,                      // Waiting for the first byte of a frame
+	FT12_VARIABLE_HEADER,           // Inside the header of a variable length frame
+	FT12_VARIABLE_BODY,             // Inside data and trailer of a variable length frame
+	FT12_FIXED                      // Inside a fixed length frame
+};
+
+// Delimits FT 1.2 frames in the byte stream read from the line.
+// Bytes not belonging to any frame are collected and written
+// as one record once the next frame starts.
+typedef struct _ft12_delimiter_t
+{
+	uint8_t state;                  // enum FT12_DELIMITER_STATES
+	uint8_t frame[FT12_MAX_FRAME_LENGTH];
+	size_t frame_len;
+	size_t expected_len;            // Length of the frame, known after its header
+	uint64_t frame_ts;              // Arrival of the first byte, nanoseconds since the epoch
+	uint8_t garbage[FT12_MAX_FRAME_LENGTH];
+	size_t garbage_len;
+	uint64_t garbage_ts;
+} ft12_delimiter_t;
+
+// Set by the signal handler when Wireshark stops the capture
+static volatile sig_atomic_t is_stopped;
+
+static FILE *pcapng_file;
+
+static void
+handle_stop_signal(int signal_number)
+{
+	(void)signal_number;
+	is_stopped = 1;
+}
+
+static uint64_t
+get_realtime_nsec(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (uint64_t)now.tv_sec * NSEC_PER_SEC + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t
+get_monotonic_msec(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+// Writes a pcapng block, padding the body to 32 bits.
+// Returns false if the stream is closed.
+static bool
+write_pcapng_block(uint32_t block_type, const uint8_t *body, size_t body_len)
+{
+	static const uint8_t padding[4] = { 0 };
+	const size_t padding_len = (4 - body_len % 4) % 4;
+	const uint32_t block_len = (uint32_t)(12 + body_len + padding_len);
+
+	return fwrite(&block_type, 4, 1, pcapng_file) == 1 &&
+			fwrite(&block_len, 4, 1, pcapng_file) == 1 &&
+			(!body_len || fwrite(body, body_len, 1, pcapng_file) == 1) &&
+			(!padding_len || fwrite(padding, padding_len, 1, pcapng_file) == 1) &&
+			fwrite(&block_len, 4, 1, pcapng_file) == 1 &&
+			fflush(pcapng_file) == 0;
+}
+
+// Writes the section header and the interface description,
+// with nanosecond timestamps.
+// Returns false if the stream is closed.
+static bool
+write_pcapng_header(void)
+{
+	uint8_t shb[16];
+	const uint32_t byte_order_magic = PCAPNG_BYTE_ORDER_MAGIC;
+	const uint16_t major_version = 1;
+	const uint16_t minor_version = 0;
+	const int64_t section_length = -1;
+	memcpy(shb, &byte_order_magic, 4);
+	memcpy(shb + 4, &major_version, 2);
+	memcpy(shb + 6, &minor_version, 2);
+	memcpy(shb + 8, &section_length, 8);
+
+	uint8_t idb[20] = { 0 };
+	const uint16_t linktype = LINKTYPE_WIRESHARK_UPPER_PDU;
+	const uint32_t snaplen = 0;
+	const uint16_t tsresol_code = PCAPNG_OPT_IF_TSRESOL;
+	const uint16_t tsresol_len = 1;
+	memcpy(idb, &linktype, 2);
+	memcpy(idb + 4, &snaplen, 4);
+	memcpy(idb + 8, &tsresol_code, 2);
+	memcpy(idb + 10, &tsresol_len, 2);
+	idb[12] = 9;
+	// Padding of if_tsresol and the end of options stay 0
+
+	return write_pcapng_block(PCAPNG_SHB, shb, sizeof(shb)) &&
+			write_pcapng_block(PCAPNG_IDB, idb, sizeof(idb));
+}
+
+// Writes a frame as exported PDU for the "baos_ft12" dissector.
+// Returns false if the stream is closed.
+static bool
+write_frame(const uint8_t *frame, size_t frame_len, uint64_t ts)
+{
+	// Tag values are padded to 32 bits, tags are big endian
+	static const uint8_t tags[] = {
+		0x00, EXP_PDU_TAG_DISSECTOR_NAME, 0x00, 12,
+		'b', 'a', 'o', 's', '_', 'f', 't', '1', '2', 0, 0, 0,
+		0x00, EXP_PDU_TAG_END_OF_OPT, 0x00, 0x00
+	};
+	_Static_assert(sizeof(BAOS_FT12_DISSECTOR_NAME) - 1 <= 12, "Dissector name doesn't fit into its tag");
+
+	uint8_t epb[20 + sizeof(tags) + FT12_MAX_FRAME_LENGTH];
+	const uint32_t interface_id = 0;
+	const uint32_t ts_high = (uint32_t)(ts >> 32);
+	const uint32_t ts_low = (uint32_t)ts;
+	const uint32_t caplen = (uint32_t)(sizeof(tags) + frame_len);
+	memcpy(epb, &interface_id, 4);
+	memcpy(epb + 4, &ts_high, 4);
+	memcpy(epb + 8, &ts_low, 4);
+	memcpy(epb + 12, &caplen, 4);
+	memcpy(epb + 16, &caplen, 4);
+	memcpy(epb + 20, tags, sizeof(tags));
+	memcpy(epb + 20 + sizeof(tags), frame, frame_len);
+
+	return write_pcapng_block(PCAPNG_EPB, epb, 20 + caplen);
+}
+
+// Writes the bytes collected outside of frames, if there are any.
+// Returns false if the stream is closed.
+static bool
+flush_garbage(ft12_delimiter_t *delimiter)
+{
+	if (!delimiter->garbage_len)
+		return true;
+
+	const bool is_written = write_frame(delimiter->garbage, delimiter->garbage_len, delimiter->garbage_ts);
+	delimiter->garbage_len = 0;
+	return is_written;
+}
+
+// Writes the frame collected so far, complete or not.
+// Returns false if the stream is closed.
+static bool
+flush_frame(ft12_delimiter_t *delimiter)
+{
+	bool is_written = flush_garbage(delimiter);
+
+	if (delimiter->frame_len)
+		is_written = is_written && write_frame(delimiter->frame, delimiter->frame_len, delimiter->frame_ts);
+
+	delimiter->frame_len = 0;
+	delimiter->state = FT12_HUNT;
+	return is_written;
+}
+
+// Adds a byte outside of any frame
+// Returns false if the stream is closed.
+static bool
+add_garbage_byte(ft12_delimiter_t *delimiter, uint8_t byte, uint64_t ts)
+{
+	if (delimiter->garbage_len == sizeof(delimiter->garbage) && !flush_garbage(delimiter))
+		return false;
+
+	if (!delimiter->garbage_len)
+		delimiter->garbage_ts = ts;
+	delimiter->garbage[delimiter->garbage_len++] = byte;
+	return true;
+}
+
+static bool
+add_byte(ft12_delimiter_t *delimiter, uint8_t byte, uint64_t ts);
+
+// Drops the frame collected so far, whose start byte has been part of
+// some other data, and looks for the next frame right after that byte.
+// Returns false if the stream is closed.
+static bool
+resync_after_start_byte(ft12_delimiter_t *delimiter, uint64_t ts)
+{
+	const size_t frame_len = delimiter->frame_len;
+	uint8_t frame[FT12_HEADER_LENGTH];
+	memcpy(frame, delimiter->frame, frame_len);
+	const uint64_t frame_ts = delimiter->frame_ts;
+
+	delimiter->frame_len = 0;
+	delimiter->state = FT12_HUNT;
+	if (!add_garbage_byte(delimiter, frame[0], frame_ts))
+		return false;
+	for (size_t i = 1; i < frame_len; i++)
+	{
+		if (!add_byte(delimiter, frame[i], ts))
+			return false;
+	}
+	return true;
+}
+
+// Feeds a byte received at the given time to the delimiter
+// and writes the frame it completes.
+// Returns false if the stream is closed.
+static bool
+add_byte(ft12_delimiter_t *delimiter, uint8_t byte, uint64_t ts)
+{
+	switch (delimiter->state)
+	{
+		case FT12_HUNT:
+			if (ft12_get_short_frame_type(&byte, 1) == FT12_ACK)
+				return flush_garbage(delimiter) && write_frame(&byte, 1, ts);
+
+			if (byte != FT12_START_BYTE && byte != FT12_FIXED_START_BYTE)
+				return add_garbage_byte(delimiter, byte, ts);
+
+			delimiter->state = byte == FT12_START_BYTE ? FT12_VARIABLE_HEADER : FT12_FIXED;
+			delimiter->expected_len = byte == FT12_START_BYTE ? FT12_HEADER_LENGTH : FT12_FIXED_FRAME_LENGTH;
+			delimiter->frame[0] = byte;
+			delimiter->frame_len = 1;
+			delimiter->frame_ts = ts;
+			return true;
+
+		case FT12_VARIABLE_HEADER:
+			delimiter->frame[delimiter->frame_len++] = byte;
+			if (delimiter->frame_len < FT12_HEADER_LENGTH)
+				return true;
+
+			// Both length bytes have to match and the second start byte has to follow,
+			// otherwise the start byte has been part of some other data
+			if (delimiter->frame[1] != delimiter->frame[2] || delimiter->frame[3] != FT12_START_BYTE)
+				return resync_after_start_byte(delimiter, ts);
+
+			delimiter->state = FT12_VARIABLE_BODY;
+			// The length covers the control byte and the data,
+			// the header has only 4 bytes without the control byte
+			delimiter->expected_len = FT12_HEADER_LENGTH - 1 + (size_t)delimiter->frame[1] + FT12_TRAILER_LENGTH;
+			return true;
+
+		case FT12_VARIABLE_BODY:
+			delimiter->frame[delimiter->frame_len++] = byte;
+			if (delimiter->frame_len < delimiter->expected_len)
+				return true;
+			return flush_frame(delimiter);
+
+		case FT12_FIXED:
+			delimiter->frame[delimiter->frame_len++] = byte;
+			if (delimiter->frame_len < delimiter->expected_len)
+				return true;
+
+			// The start byte of a fixed length frame is a common value,
+			// it's only taken for one if the checksum and end byte follow
+			if (ft12_get_short_frame_type(delimiter->frame, delimiter->frame_len) != FT12_FIXED_FRAME)
+				return resync_after_start_byte(delimiter, ts);
+			return flush_frame(delimiter);
+	}
+	return true;
+}
+
+// Opens the serial device for reading only, in raw mode
+// with 8 data bits and even parity as used by FT 1.2.
+// Returns the file descriptor, or -1 on error.
+static int
+open_serial_device(const char *device, unsigned baudrate)
+{
+	const int fd = open(device, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+	if (fd < 0)
+	{
+		fprintf(stderr, "baosserialdump: %s: %s\n", device, strerror(errno));
+		return -1;
+	}
+
+	struct termios settings;
+	if (tcgetattr(fd, &settings) < 0)
+	{
+		fprintf(stderr, "baosserialdump: %s: %s\n", device, strerror(errno));
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&settings);
+	settings.c_cflag |= CLOCAL | CREAD | PARENB;
+	settings.c_cflag &= ~(PARODD | CSTOPB);
+	settings.c_cc[VMIN] = 1;
+	settings.c_cc[VTIME] = 0;
+
+	const speed_t speed = baudrate == BAUD_115200_BPS ? B115200 : B19200;
+	if (cfsetispeed(&settings, speed) < 0 || cfsetospeed(&settings, speed) < 0 ||
+		tcsetattr(fd, TCSANOW, &settings) < 0)
+	{
+		fprintf(stderr, "baosserialdump: %s: %s\n", device, strerror(errno));
+		close(fd);
+		return -1;
+	}
+	tcflush(fd, TCIFLUSH);
+	return fd;
+}
+
+// Reads the serial device until the capture is stopped.
+// Returns the exit code of the extcap.
+static int
+capture(const char *device, unsigned baudrate, unsigned frame_timeout_ms, const char *fifo)
+{
+	const int fd = open_serial_device(device, baudrate);
+	if (fd < 0)
+		return 1;
+
+	pcapng_file = fopen(fifo, "wb");
+	if (!pcapng_file)
+	{
+		fprintf(stderr, "baosserialdump: %s: %s\n", fifo, strerror(errno));
+		close(fd);
+		return 1;
+	}
+	if (!write_pcapng_header())
+	{
+		fclose(pcapng_file);
+		close(fd);
+		return 1;
+	}
+
+	// A read returns bytes which have been received one character time
+	// apart, so the arrival of earlier bytes is calculated backwards
+	// from the time of the read
+	const uint64_t char_nsec = FT12_BITS_PER_CHAR * NSEC_PER_SEC / baudrate;
+
+	ft12_delimiter_t delimiter = { 0 };
+	uint64_t last_byte_msec = get_monotonic_msec();
+	uint64_t last_byte_ts = 0;
+	bool is_ok = true;
+
+	while (!is_stopped && is_ok)
+	{
+		struct pollfd poll_fd = { .fd = fd, .events = POLLIN };
+		const int ready = poll(&poll_fd, 1, 10);
+		if (ready < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			fprintf(stderr, "baosserialdump: %s: %s\n", device, strerror(errno));
+			break;
+		}
+
+		if (ready && (poll_fd.revents & POLLIN))
+		{
+			uint8_t bytes[4096];
+			const ssize_t nr_of_bytes = read(fd, bytes, sizeof(bytes));
+			const uint64_t read_ts = get_realtime_nsec();
+
+			if (nr_of_bytes < 0 && errno != EAGAIN && errno != EINTR)
+			{
+				fprintf(stderr, "baosserialdump: %s: %s\n", device, strerror(errno));
+				break;
+			}
+			for (ssize_t i = 0; i < nr_of_bytes && is_ok; i++)
+			{
+				// Bytes can't have arrived before the ones of the previous read
+				uint64_t byte_ts = read_ts - (uint64_t)(nr_of_bytes - 1 - i) * char_nsec;
+				byte_ts = byte_ts > last_byte_ts ? byte_ts : last_byte_ts;
+				last_byte_ts = byte_ts;
+
+				is_ok = add_byte(&delimiter, bytes[i], byte_ts);
+			}
+
+			if (nr_of_bytes > 0)
+				last_byte_msec = get_monotonic_msec();
+		}
+		else if (ready && (poll_fd.revents & (POLLHUP | POLLERR)))
+		{
+			// Other end of a pseudo terminal closed, wait for it to reopen
+			usleep(10000);
+		}
+
+		// Give up on frames the line went silent in
+		if ((delimiter.frame_len || delimiter.garbage_len) &&
+			get_monotonic_msec() - last_byte_msec >= frame_timeout_ms)
+			is_ok = flush_frame(&delimiter);
+	}
+
+	if (is_ok)
+		flush_frame(&delimiter);
+	fclose(pcapng_file);
+	close(fd);
+	return 0;
+}
+
+static void
+print_interfaces(void)
+{
+	printf("extcap {version=%s}\n", BAOSSERIALDUMP_VERSION);
+	printf("interface {value=%s}{display=Serial BAOS (FT 1.2) capture}\n", BAOSSERIALDUMP_INTERFACE);
+}
+
+static void
+print_dlts(void)
+{
+	printf("dlt {number=%d}{name=WIRESHARK_UPPER_PDU}{display=FT 1.2 frames for the BAOS dissector}\n",
+			LINKTYPE_WIRESHARK_UPPER_PDU);
+}
+
+static void
+print_config(void)
+{
+	printf("arg {number=0}{call=--device}{display=Serial device}{type=fileselect}{mustexist=true}"
+			"{required=true}{tooltip=Serial port the RS-232 line is tapped with, e.g. /dev/ttyUSB0}\n");
+	printf("arg {number=1}{call=--baudrate}{display=Baud rate}{type=selector}"
+			"{tooltip=Baud rate of the BAOS device}\n");
+	printf("value {arg=1}{value=%d}{display=19200}{default=true}\n", BAUD_19200_BPS);
+	printf("value {arg=1}{value=%d}{display=115200}{default=false}\n", BAUD_115200_BPS);
+	printf("arg {number=2}{call=--frame-timeout}{display=Frame timeout (ms)}{type=unsigned}"
+			"{default=%d}{range=1,10000}{tooltip=Idle time after which an incomplete frame is written as it is}\n",
+			DEFAULT_FRAME_TIMEOUT_MS);
+}
+
+static void
+print_usage(FILE *stream)
+{
+	fprintf(stream,
+			"Usage: baosserialdump --extcap-interfaces\n"
+			"       baosserialdump --extcap-interface=%s --extcap-dlts\n"
+			"       baosserialdump --extcap-interface=%s --extcap-config\n"
+			"       baosserialdump --extcap-interface=%s --capture --fifo=FILE --device=TTY\n"
+			"                      [--baudrate=19200|115200] [--frame-timeout=MS]\n",
+			BAOSSERIALDUMP_INTERFACE, BAOSSERIALDUMP_INTERFACE, BAOSSERIALDUMP_INTERFACE);
+}
+
+enum OPTIONS
+{
+	OPT_EXTCAP_INTERFACES = 1,
+	OPT_EXTCAP_INTERFACE,
+	OPT_EXTCAP_DLTS,
+	OPT_EXTCAP_CONFIG,
+	OPT_EXTCAP_VERSION,
+	OPT_EXTCAP_CAPTURE_FILTER,
+	OPT_CAPTURE,
+	OPT_FIFO,
+	OPT_DEVICE,
+	OPT_BAUDRATE,
+	OPT_FRAME_TIMEOUT,
+	OPT_HELP
+};
+
+int
+main(int argc, char *argv[])
+{
+	static const struct option options[] = {
+		{"extcap-interfaces", no_argument, NULL, OPT_EXTCAP_INTERFACES},
+		{"extcap-interface", required_argument, NULL, OPT_EXTCAP_INTERFACE},
+		{"extcap-dlts", no_argument, NULL, OPT_EXTCAP_DLTS},
+		{"extcap-config", no_argument, NULL, OPT_EXTCAP_CONFIG},
+		{"extcap-version", optional_argument, NULL, OPT_EXTCAP_VERSION},
+		{"extcap-capture-filter", required_argument, NULL, OPT_EXTCAP_CAPTURE_FILTER},
+		{"capture", no_argument, NULL, OPT_CAPTURE},
+		{"fifo", required_argument, NULL, OPT_FIFO},
+		{"device", required_argument, NULL, OPT_DEVICE},
+		{"baudrate", required_argument, NULL, OPT_BAUDRATE},
+		{"frame-timeout", required_argument, NULL, OPT_FRAME_TIMEOUT},
+		{"help", no_argument, NULL, OPT_HELP},
+		{NULL, 0, NULL, 0}
+	};
+
+	bool is_interfaces = false;
+	bool is_dlts = false;
+	bool is_config = false;
+	bool is_capture = false;
+	const char *interface = NULL;
+	const char *fifo = NULL;
+	const char *device = NULL;
+	unsigned long baudrate = BAUD_19200_BPS;
+	unsigned long frame_timeout_ms = DEFAULT_FRAME_TIMEOUT_MS;
+	int option;
+
+	while ((option = getopt_long(argc, argv, "", options, NULL)) != -1)
+	{
+		switch (option)
+		{
+			case OPT_EXTCAP_INTERFACES:
+				is_interfaces = true;
+				break;
+			case OPT_EXTCAP_INTERFACE:
+				interface = optarg;
+				break;
+			case OPT_EXTCAP_DLTS:
+				is_dlts = true;
+				break;
+			case OPT_EXTCAP_CONFIG:
+				is_config = true;
+				break;
+			case OPT_EXTCAP_VERSION:
+			case OPT_EXTCAP_CAPTURE_FILTER:
+				break;
+			case OPT_CAPTURE:
+				is_capture = true;
+				break;
+			case OPT_FIFO:
+				fifo = optarg;
+				break;
+			case OPT_DEVICE:
+				device = optarg;
+				break;
+			case OPT_BAUDRATE:
+				baudrate = strtoul(optarg, NULL, 10);
+				break;
+			case OPT_FRAME_TIMEOUT:
+				frame_timeout_ms = strtoul(optarg, NULL, 10);
+				break;
+			case OPT_HELP:
+				print_usage(stdout);
+				return 0;
+			default:
+				print_usage(stderr);
+				return 1;
+		}
+	}
+
+	if (is_interfaces)
+	{
+		print_interfaces();
+		return 0;
+	}
+	if (!interface || strcmp(interface, BAOSSERIALDUMP_INTERFACE) != 0)
+	{
+		print_usage(stderr);
+		return 1;
+	}
+	if (is_dlts)
+	{
+		print_dlts();
+		return 0;
+	}
+	if (is_config)
+	{
+		print_config();
+		return 0;
+	}
+	if (!is_capture || !fifo || !device)
+	{
+		print_usage(stderr);
+		return 1;
+	}
+	if (baudrate != BAUD_19200_BPS && baudrate != BAUD_115200_BPS)
+	{
+		fprintf(stderr, "baosserialdump: baud rate must be %d or %d\n", BAUD_19200_BPS, BAUD_115200_BPS);
+		return 1;
+	}
+	if (!frame_timeout_ms)
+		frame_timeout_ms = DEFAULT_FRAME_TIMEOUT_MS;
+
+	// Wireshark stops the capture with SIGTERM,
+	// a closed FIFO is noticed by the failing write
+	struct sigaction stop_action = { 0 };
+	stop_action.sa_handler = handle_stop_signal;
+	sigaction(SIGTERM, &stop_action, NULL);
+	sigaction(SIGINT, &stop_action, NULL);
+	signal(SIGPIPE, SIG_IGN);
+
+	return capture(device, (unsigned)baudrate, (unsigned)frame_timeout_ms, fifo);
+}
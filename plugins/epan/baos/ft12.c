@@ -0,0 +1,354 @@
+/* ft12.c
+ *
+ * FT 1.2 framing of serial BAOS telegrams, shared by the
+ * BAOS dissector and the standalone tools. Free of epan.
+ * By Adam Rigely <adamrigely@pm.me>
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ */
+
+#include <string.h>
+
+#include "ft12.h"
+
+// Loads 8 bytes as a little endian 64 bit word
+static inline uint64_t
+ft12_load_le64(const uint8_t *bytes)
+{
+	uint64_t word = 0;
+	for (int i = 7; i >= 0; i--)
+		word = (word << 8) | bytes[i];
+	return word;
+}
+
+// Counts the trailing zero bits of a word, which must not be 0
+static inline int
+ft12_ctz64(uint64_t word)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(word);
+#else
+	int count = 0;
+	while (!(word & 1))
+	{
+		word >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Checks for the FT 1.2 + BAOS payload pattern at the given index.
+// Returns true if both FT 1.2 start bytes, a valid control byte
+// and the BAOS main service code have been found.
+bool
+ft12_is_baos_pattern_at(const uint8_t *bytes, size_t length, size_t start_byte_index)
+{
+	if (length < start_byte_index + 6)
+		return false;
+
+	const uint8_t control_byte = bytes[start_byte_index + 4];
+
+	return bytes[start_byte_index] == FT12_START_BYTE &&
+			bytes[start_byte_index + 3] == FT12_START_BYTE &&
+			(
+				control_byte == CR_RX_ODD	||
+				control_byte == CR_RX_EVEN	||
+				control_byte == CR_TX_ODD	||
+				control_byte == CR_TX_EVEN
+			) &&
+			bytes[start_byte_index + 5] == BAOS_MAINSERVICE_CODE;
+}
+
+// Looks for FT 1.2 + BAOS payload pattern in the first bytes of a buffer.
+// Returns either the index of the FT 1.2 start byte,
+// or UINT8_MAX if pattern has not been found.
+//
+// All start byte indexes are tested at once,
+// with every byte in its own lane of a 64 bit word.
+// Only a match is confirmed byte by byte.
+uint8_t
+ft12_find_baos_pattern(const uint8_t *bytes, size_t length)
+{
+	// The pattern is 6 bytes long, so bytes 0 to 9 are needed
+	// for the start byte indexes 0 to 4. Missing bytes stay 0,
+	// which doesn't match any byte of the pattern.
+	uint8_t padded_bytes[16] = { 0 };
+	memcpy(padded_bytes, bytes, length < sizeof(padded_bytes) ? length : sizeof(padded_bytes));
+
+	// Lane i of each word holds the byte, which is expected
+	// to be a certain part of the pattern if it starts at index i
+	const uint64_t first_start_bytes	= ft12_load_le64(padded_bytes);
+	const uint64_t second_start_bytes	= ft12_load_le64(padded_bytes + 3);
+	const uint64_t control_bytes		= ft12_load_le64(padded_bytes + 4);
+	const uint64_t main_service_bytes	= ft12_load_le64(padded_bytes + 5);
+
+	// Lanes are 0 where the byte matches. The four valid control bytes
+	// only differ in bits 5 and 7, so they all match 0x53 without them.
+	const uint64_t mismatches =
+			(first_start_bytes ^ SWAR_REPEAT(FT12_START_BYTE)) |
+			(second_start_bytes ^ SWAR_REPEAT(FT12_START_BYTE)) |
+			((control_bytes & SWAR_REPEAT(0x5F)) ^ SWAR_REPEAT(CR_TX_EVEN)) |
+			(main_service_bytes ^ SWAR_REPEAT(BAOS_MAINSERVICE_CODE));
+
+	// Set the high bit of every lane that is 0, without carries between lanes
+	const uint64_t low_bits = SWAR_REPEAT(0x7F);
+	uint64_t matches = ~(((mismatches & low_bits) + low_bits) | mismatches | low_bits);
+	matches &= SWAR_START_BYTE_LANES;
+
+	while (matches)
+	{
+		const uint8_t start_byte_index = (uint8_t)(ft12_ctz64(matches) / 8);
+		if (ft12_is_baos_pattern_at(padded_bytes, sizeof(padded_bytes), start_byte_index))
+			return start_byte_index;
+
+		// Clear the lowest match
+		matches &= matches - 1;
+	}
+	return UINT8_MAX;
+}
+
+// Calculates the checksum of the FT 1.2 frame based
+// on algorithm documented in the BAOS documentation,
+// over the bytes from the control byte to the checksum.
+// Returns the calculated checksum.
+uint8_t
+ft12_checksum(const uint8_t *bytes, size_t length)
+{
+	uint32_t sum_of_bytes = 0;
+	for (size_t i = 0; i < length; i++)
+		sum_of_bytes += bytes[i];
+
+	return (uint8_t)(sum_of_bytes % 256);
+}
+
+// Looks for an FT 1.2 frame carrying a BAOS telegram at the
+// start of a buffer, which may end before the frame does.
+// Returns false if there is none.
+bool
+ft12_parse_baos_frame(const uint8_t *bytes, size_t length, ft12_frame_t *frame)
+{
+	const uint8_t start_byte_index = ft12_find_baos_pattern(bytes, length);
+	if (start_byte_index == UINT8_MAX)
+		return false;
+
+	// The FT 1.2 length covers at least the control byte,
+	// the BAOS main service and the subservice
+	const uint8_t ft12_length = bytes[start_byte_index + 1];
+	if (ft12_length < 3 || length < (size_t)start_byte_index + FT12_HEADER_LENGTH + 2)
+		return false;
+
+	memset(frame, 0, sizeof(*frame));
+	frame->start_byte_index = start_byte_index;
+	frame->control_byte = bytes[start_byte_index + 4];
+	frame->subservice = bytes[start_byte_index + FT12_HEADER_LENGTH + 1];
+	frame->baos_payload_len = ft12_length - 1;
+	frame->trailer_start_index = start_byte_index + FT12_HEADER_LENGTH + frame->baos_payload_len;
+
+	if (length > frame->trailer_start_index)
+	{
+		const uint16_t control_byte_index = start_byte_index + 4;
+		frame->is_checksum_known = true;
+		frame->is_checksum_ok = ft12_checksum(bytes + control_byte_index, frame->trailer_start_index - control_byte_index) ==
+									bytes[frame->trailer_start_index];
+	}
+	frame->is_complete = length > (size_t)frame->trailer_start_index + 1 &&
+							bytes[frame->trailer_start_index + 1] == FT12_END_BYTE;
+
+	return true;
+}
+
+// Looks up the object server response of a BAOS response telegram.
+// Set*Res telegrams always carry one, Get*Res telegrams only
+// if they report an error instead of items.
+// Returns false if the telegram doesn't carry a response code.
+bool
+ft12_get_baos_response_code(const uint8_t *bytes, size_t length, const ft12_frame_t *frame, uint8_t *response_code)
+{
+	const size_t baos_start_index = (size_t)frame->start_byte_index + FT12_HEADER_LENGTH;
+
+	if (frame->subservice < GET_SERVER_ITEM_RES_CODE || frame->subservice > SET_PARAMETER_BYTE_RES_CODE)
+		return false;
+	if (frame->baos_payload_len < 7 || length < baos_start_index + 7)
+		return false;
+
+	const bool is_set_response = frame->subservice == SET_SERVER_ITEM_RES_CODE ||
+									frame->subservice == SET_DATAPOINT_VALUE_RES_CODE ||
+									frame->subservice == SET_PARAMETER_BYTE_RES_CODE;
+	const uint16_t nr_of_items = (uint16_t)(bytes[baos_start_index + 4] << 8 | bytes[baos_start_index + 5]);
+
+	if (!is_set_response && nr_of_items)
+		return false;
+
+	*response_code = bytes[baos_start_index + 6];
+	return true;
+}
+
+// Checks if a buffer holds an FT 1.2 single character acknowledgement
+// or a fixed length frame, and nothing else.
+// Returns the type of the frame, or UINT8_MAX if it's neither.
+uint8_t
+ft12_get_short_frame_type(const uint8_t *bytes, size_t length)
+{
+	if (length == 1 && bytes[0] == FT12_ACK_BYTE)
+		return FT12_ACK;
+
+	// The checksum of the control byte is the control byte
+	if (length == FT12_FIXED_FRAME_LENGTH && bytes[0] == FT12_FIXED_START_BYTE &&
+		bytes[2] == bytes[1] && bytes[3] == FT12_END_BYTE)
+		return FT12_FIXED_FRAME;
+
+	return UINT8_MAX;
+}
+
+void
+ft12_scanner_init(ft12_scanner_t *scanner)
+{
+	memset(scanner, 0, sizeof(*scanner));
+}
+
+// Skips the byte the scanner is looking at, which doesn't start a frame
+static inline void
+ft12_scanner_skip(ft12_scanner_t *scanner)
+{
+	scanner->start++;
+	scanner->skipped_bytes++;
+	scanner->total_skipped_bytes++;
+}
+
+// Looks for the next valid FT 1.2 frame, taking bytes from the input
+// as needed and advancing it. Frames may span several inputs.
+// Returns true if a frame has been found, or false
+// if all input is used up before the next frame.
+bool
+ft12_scanner_next(ft12_scanner_t *scanner, const uint8_t **bytes, size_t *length, ft12_scan_result_t *frame)
+{
+	for (;;)
+	{
+		while (scanner->start < scanner->end)
+		{
+			const uint8_t *candidate = scanner->window + scanner->start;
+			const size_t available = scanner->end - scanner->start;
+			uint8_t type = FT12_VARIABLE_FRAME;
+			size_t frame_length = 1;
+
+			switch (candidate[0])
+			{
+				case FT12_ACK_BYTE:
+					type = FT12_ACK;
+					break;
+
+				case FT12_FIXED_START_BYTE:
+					type = FT12_FIXED_FRAME;
+					frame_length = FT12_FIXED_FRAME_LENGTH;
+					break;
+
+				case FT12_START_BYTE:
+					// Header: start byte, length byte twice, start byte
+					frame_length = FT12_HEADER_LENGTH - 1;
+					if (available < frame_length)
+						break;
+
+					if (!candidate[1] || candidate[2] != candidate[1] || candidate[3] != FT12_START_BYTE)
+						frame_length = 0;
+					else
+						// The length covers the control byte and the data
+						frame_length += candidate[1] + FT12_TRAILER_LENGTH;
+					break;
+
+				default:
+					frame_length = 0;
+					break;
+			}
+			if (!frame_length)
+			{
+				ft12_scanner_skip(scanner);
+				continue;
+			}
+
+			// Once the last input is in the window,
+			// frames can't be completed anymore
+			if (available < frame_length)
+			{
+				if (!scanner->is_finished || *length)
+					break;
+				ft12_scanner_skip(scanner);
+				continue;
+			}
+
+			bool is_valid = true;
+			if (type == FT12_FIXED_FRAME)
+			{
+				// The checksum of the control byte is the control byte
+				is_valid = candidate[2] == candidate[1] && candidate[3] == FT12_END_BYTE;
+			}
+			else if (type == FT12_VARIABLE_FRAME)
+			{
+				const size_t control_byte_index = scanner->start + FT12_HEADER_LENGTH - 1;
+				const size_t checksum_index = scanner->start + frame_length - FT12_TRAILER_LENGTH;
+				const uint8_t checksum = (uint8_t)(scanner->sums[checksum_index] - scanner->sums[control_byte_index]);
+				is_valid = scanner->window[checksum_index] == checksum && scanner->window[checksum_index + 1] == FT12_END_BYTE;
+			}
+			if (!is_valid)
+			{
+				ft12_scanner_skip(scanner);
+				continue;
+			}
+
+			frame->offset = scanner->window_offset + scanner->start;
+			frame->type = type;
+			frame->bytes = candidate;
+			frame->length = (uint16_t)frame_length;
+			frame->skipped_bytes = scanner->skipped_bytes;
+
+			if (scanner->skipped_bytes)
+				scanner->nr_of_resyncs++;
+			scanner->nr_of_frames++;
+			scanner->skipped_bytes = 0;
+			scanner->start += frame_length;
+			return true;
+		}
+
+		if (!*length)
+			return false;
+
+		// Move the bytes not looked at yet to the front. The running
+		// sums move along, their differences stay the same.
+		if (scanner->start)
+		{
+			const size_t remaining = scanner->end - scanner->start;
+			memmove(scanner->window, scanner->window + scanner->start, remaining);
+			memmove(scanner->sums, scanner->sums + scanner->start, remaining + 1);
+			scanner->window_offset += scanner->start;
+			scanner->start = 0;
+			scanner->end = remaining;
+		}
+
+		// There is room for at least the longest frame
+		size_t nr_of_bytes = FT12_SCAN_WINDOW_SIZE - scanner->end;
+		nr_of_bytes = nr_of_bytes < *length ? nr_of_bytes : *length;
+		for (size_t i = 0; i < nr_of_bytes; i++)
+		{
+			scanner->window[scanner->end] = (*bytes)[i];
+			scanner->sums[scanner->end + 1] = (uint8_t)(scanner->sums[scanner->end] + (*bytes)[i]);
+			scanner->end++;
+		}
+		*bytes += nr_of_bytes;
+		*length -= nr_of_bytes;
+	}
+}
+
+// Marks the end of the stream, either before the last input is handed
+// to ft12_scanner_next() or after it, to take the frames left in the
+// scanner without further input. Bytes of a frame the stream ends in
+// are skipped.
+void
+ft12_scanner_finish(ft12_scanner_t *scanner)
+{
+	scanner->is_finished = true;
+}
@@ -0,0 +1,198 @@
+/* ft12.h
+ *
+ * FT 1.2 framing of serial BAOS telegrams, shared by the
+ * BAOS dissector and the standalone tools. Free of epan.
+ * By Adam Rigely <adamrigely@pm.me>
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ */
+
+#ifndef FT12_H
+#define FT12_H
+
+// Imports
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Macros for readability
+#define FT12_START_BYTE 0x68
+#define FT12_END_BYTE 0x16
+#define BAOS_MAINSERVICE_CODE 0xF0
+#define FT12_MAX_START_BYTE_INDEX 4
+
+// Single character acknowledgement and fixed length frames
+// (start byte, control byte, checksum, end byte)
+#define FT12_ACK_BYTE 0xE5
+#define FT12_FIXED_START_BYTE 0x10
+#define FT12_FIXED_FRAME_LENGTH 4
+
+// Control byte bits. Frames sent by the primary station are acknowledged
+// by the other side, BAOS devices set the direction bit in their frames.
+#define FT12_CONTROL_DIR 0x80
+#define FT12_CONTROL_PRM 0x40
+#define FT12_CONTROL_FUNCTION 0x0F
+
+// Length of the FT 1.2 header (start byte, length byte twice,
+// start byte, control byte) and of the trailer (checksum, end byte)
+#define FT12_HEADER_LENGTH 5
+#define FT12_TRAILER_LENGTH 2
+
+// Longest FT 1.2 frame: header without the control byte,
+// control byte and up to 254 bytes of data, trailer
+#define FT12_MAX_FRAME_LENGTH (FT12_HEADER_LENGTH - 1 + UINT8_MAX + FT12_TRAILER_LENGTH)
+
+// Bytes the scanner keeps while it waits for the rest of a frame
+#define FT12_SCAN_WINDOW_SIZE (2 * FT12_MAX_FRAME_LENGTH)
+
+// Repeats a byte in every lane of a 64 bit word
+#define SWAR_REPEAT(byte) (UINT64_C(0x0101010101010101) * (uint8_t)(byte))
+// Lanes that may hold an FT 1.2 start byte, one per start byte index
+#define SWAR_START_BYTE_LANES (SWAR_REPEAT(0x80) >> (8 * (7 - FT12_MAX_START_BYTE_INDEX)))
+
+// Refer to the BAOS documentation to
+// find out more about the available subservices.
+enum SUBSERVICE_CODES
+{
+    GET_SERVER_ITEM_REQ_CODE        = 0x01,
+    SET_SERVER_ITEM_REQ_CODE        = 0x02,
+    GET_DATAPOINT_DESC_REQ_CODE     = 0x03,
+    GET_DESC_STRING_REQ_CODE        = 0x04,
+    GET_DATAPOINT_VALUE_REQ_CODE    = 0x05,
+    SET_DATAPOINT_VALUE_REQ_CODE    = 0x06,
+    GET_PARAMETER_BYTE_REQ_CODE     = 0x07,
+    SET_PARAMETER_BYTE_REQ_CODE     = 0x08,
+    GET_SERVER_ITEM_RES_CODE        = 0x81,
+    SET_SERVER_ITEM_RES_CODE        = 0x82,
+    GET_DATAPOINT_DESC_RES_CODE     = 0x83,
+    GET_DESC_STRING_RES_CODE        = 0x84,
+    GET_DATAPOINT_VALUE_RES_CODE    = 0x85,
+    SET_DATAPOINT_VALUE_RES_CODE    = 0x86,
+    GET_PARAMETER_BYTE_RES_CODE     = 0x87,
+    SET_PARAMETER_BYTE_RES_CODE     = 0x88,
+    DATAPOINT_VALUE_IND_CODE        = 0xC1,
+    SERVER_ITEM_IND_CODE            = 0xC2
+};
+
+// Refer to Appendix B in the BAOS documentation
+// to find out more about the available error codes.
+enum OBJECT_SERVER_RESPONSE_CODES
+{
+    SUCCESS                 = 0x00,
+    INTERNAL_ERROR          = 0x01,
+    NO_ELEMENT_FOUND        = 0x02,
+    BUFFER_TOO_SMALL        = 0x03,
+    ITEM_NOT_WRITABLE       = 0x04,
+    SERVICE_NOT_SUPPORTED   = 0x05,
+    BAD_SERVICE_PARAMETER   = 0x06,
+    BAD_ID                  = 0x07,
+    BAD_COMMAND_VALUE       = 0x08,
+    BAD_LENGTH              = 0x09,
+    MESSAGE_INCONSISTENT    = 0x0A,
+    OBJECT_SERVER_BUSY      = 0x0B
+};
+
+enum CONTROL_BYTES
+{
+    CR_TX_ODD   = 0x73,
+    CR_TX_EVEN  = 0x53,
+    CR_RX_ODD   = 0xF3,
+    CR_RX_EVEN  = 0xD3
+};
+
+enum FT12_FRAME_TYPES
+{
+    FT12_VARIABLE_FRAME = 0,
+    FT12_FIXED_FRAME    = 1,
+    FT12_ACK            = 2
+};
+
+// Function codes of fixed length frames,
+// refer to IEC 60870-5-2 for the full list
+enum FT12_FUNCTION_CODES
+{
+    FT12_PRM_RESET_LINK         = 0x00,
+    FT12_PRM_RESET_USER_PROCESS = 0x01,
+    FT12_PRM_REQUEST_STATUS     = 0x09,
+    FT12_SEC_ACK                = 0x00,
+    FT12_SEC_NACK               = 0x01,
+    FT12_SEC_STATUS             = 0x0B
+};
+
+// FT 1.2 frame carrying a BAOS telegram, as found in a buffer
+typedef struct _ft12_frame_t
+{
+    uint8_t start_byte_index;       // Index of the first FT 1.2 start byte
+    uint8_t control_byte;
+    uint8_t subservice;
+    uint8_t baos_payload_len;       // BAOS main service, subservice and data
+    uint16_t trailer_start_index;   // Index of the checksum
+    bool is_complete;               // End byte found at the expected index
+    bool is_checksum_known;         // Checksum present in the buffer
+    bool is_checksum_ok;
+} ft12_frame_t;
+
+// FT 1.2 frame or acknowledgement found in a byte stream by the scanner
+typedef struct _ft12_scan_result_t
+{
+    uint64_t offset;                // Offset of the first start byte in the stream
+    uint8_t type;                   // enum FT12_FRAME_TYPES
+    const uint8_t *bytes;           // Valid until the scanner is called again
+    uint16_t length;
+    uint64_t skipped_bytes;         // Bytes in front of the frame, not part of any frame
+} ft12_scan_result_t;
+
+// Finds valid FT 1.2 frames in a byte stream of any length, which may
+// start in the middle of a frame or lose bytes. Every start byte is
+// checked for the repeated length, second start byte, checksum and end
+// byte, with the checksum taken from running sums, so each byte of the
+// stream is looked at a constant number of times. Acknowledgements
+// and fixed length frames are found between frames.
+typedef struct _ft12_scanner_t
+{
+    uint8_t window[FT12_SCAN_WINDOW_SIZE];
+    uint8_t sums[FT12_SCAN_WINDOW_SIZE + 1];    // sums[i] is the sum of window[0] to window[i - 1]
+    size_t start;                   // Next byte to look at
+    size_t end;
+    uint64_t window_offset;         // Offset of window[0] in the stream
+    uint64_t skipped_bytes;         // Bytes skipped since the last frame
+    uint64_t nr_of_frames;
+    uint64_t nr_of_resyncs;         // Frames found after skipped bytes
+    uint64_t total_skipped_bytes;
+    bool is_finished;               // End of the stream reached
+} ft12_scanner_t;
+
+// Function prototypes
+bool
+ft12_is_baos_pattern_at(const uint8_t *bytes, size_t length, size_t start_byte_index);
+
+uint8_t
+ft12_find_baos_pattern(const uint8_t *bytes, size_t length);
+
+uint8_t
+ft12_checksum(const uint8_t *bytes, size_t length);
+
+bool
+ft12_parse_baos_frame(const uint8_t *bytes, size_t length, ft12_frame_t *frame);
+
+bool
+ft12_get_baos_response_code(const uint8_t *bytes, size_t length, const ft12_frame_t *frame, uint8_t *response_code);
+
+uint8_t
+ft12_get_short_frame_type(const uint8_t *bytes, size_t length);
+
+void
+ft12_scanner_init(ft12_scanner_t *scanner);
+
+bool
+ft12_scanner_next(ft12_scanner_t *scanner, const uint8_t **bytes, size_t *length, ft12_scan_result_t *frame);
+
+void
+ft12_scanner_finish(ft12_scanner_t *scanner);
+
+#endif
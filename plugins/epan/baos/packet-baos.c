@@ -19,51 +19,56 @@
 uint8_t
 check_serial_baos_pattern(tvbuff_t *tvb)
 {
-	bool is_ft12_found = false;
-	bool is_baos_found = false;
-	uint8_t start_byte_index = 0;
+	const unsigned length = MIN(tvb->length, 16);
+	return ft12_find_baos_pattern(tvb_get_ptr(tvb, 0, length), length);
+}
+
+// Finds out why the heuristic rejected a TVB without the FT 1.2 + BAOS
+// pattern, by how far the best start byte index got into the pattern.
+// The TVB must be long enough for all start byte indexes.
+uint8_t
+get_baos_heur_reject_reason(tvbuff_t *tvb)
+{
+	uint8_t reason = BAOS_HEUR_NO_START_BYTE;
 
-	while (start_byte_index < 5)
+	for (uint8_t start_byte_index = 0; start_byte_index <= FT12_MAX_START_BYTE_INDEX; start_byte_index++)
 	{
-		const uint8_t first_start_byte = tvb_get_uint8(tvb, start_byte_index);
-		// First start byte found
-		if (first_start_byte == FT12_START_BYTE)
-		{
-			const uint8_t second_start_byte = tvb_get_uint8(tvb, start_byte_index + 3);
-			// Second start byte found
-			if (second_start_byte == FT12_START_BYTE)
-			{
-				uint8_t control_byte = tvb_get_uint8(tvb, start_byte_index + 4);
-				if (
-					control_byte == CR_RX_ODD	||
-					control_byte == CR_RX_EVEN	||
-					control_byte == CR_TX_ODD	||
-					control_byte == CR_TX_EVEN
-					)
-					is_ft12_found = true;
-			}
-		}
-		if (is_ft12_found)
+		if (tvb_get_uint8(tvb, start_byte_index) != FT12_START_BYTE ||
+			tvb_get_uint8(tvb, start_byte_index + 3) != FT12_START_BYTE)
+			continue;
+
+		const uint8_t control_byte = tvb_get_uint8(tvb, start_byte_index + 4);
+		if (
+			control_byte != CR_RX_ODD	&&
+			control_byte != CR_RX_EVEN	&&
+			control_byte != CR_TX_ODD	&&
+			control_byte != CR_TX_EVEN
+			)
 		{
-			uint8_t baos_main_service_byte = tvb_get_uint8(tvb, start_byte_index + 5);
-			if (baos_main_service_byte == BAOS_MAINSERVICE_CODE)
-				is_baos_found = true;
-			else
-				is_ft12_found = false;
+			reason = MAX(reason, BAOS_HEUR_BAD_CONTROL_BYTE);
+			continue;
 		}
-		if (is_ft12_found && is_baos_found)
-			return start_byte_index;
-
-		start_byte_index++;
+		return BAOS_HEUR_BAD_MAIN_SERVICE;
 	}
-	return UINT8_MAX;
+	return reason;
+}
+
+// Hands the outcome of the heuristic to the taps.
+// Callers only get here for USB transfers when there is anybody listening.
+void
+queue_baos_heur_result(tvbuff_t *tvb, packet_info *pinfo, uint8_t result)
+{
+	baos_heur_info_t *heur_info = wmem_new(pinfo->pool, baos_heur_info_t);
+	heur_info->result = result;
+	heur_info->length = tvb->length;
+	tap_queue_packet(baos_heur_tap, pinfo, heur_info);
 }
 
 // Checks if FT 1.2 frame is complete by looking
 // for the FT 1.2 endbyte at the expected index.
 // Returns true if endbyte has been found, false otherwise.
 bool
-check_packet_integrity(tvbuff_t *tvb, uint8_t trailer_start_index)
+check_packet_integrity(tvbuff_t *tvb, uint16_t trailer_start_index)
 {
 	// Check if FT 1.2 endbyte will be found at the expected index
 
@@ -79,1366 +84,4547 @@ check_packet_integrity(tvbuff_t *tvb, uint8_t trailer_start_index)
 // on algorithm documented in the BAOS documentation.
 // Returns the calculated checksum.
 uint32_t
-calculateChecksum(tvbuff_t *tvb, uint8_t start_byte_index, uint8_t trailer_start_index)
+calculateChecksum(tvbuff_t *tvb, uint8_t start_byte_index, uint16_t trailer_start_index)
 {
-	const uint8_t controllbyte_index = start_byte_index + 4;
+	const uint16_t controllbyte_index = start_byte_index + 4;
 
-	uint32_t sum_of_bytes = 0;
-	for (uint8_t i = controllbyte_index; i < trailer_start_index; i++)
-	{
-		sum_of_bytes += tvb_get_uint8(tvb, i);
-	}
-	// Calculated checksum
-	return sum_of_bytes % 256;
+	return ft12_checksum(tvb_get_ptr(tvb, controllbyte_index, trailer_start_index - controllbyte_index),
+							trailer_start_index - controllbyte_index);
 }
 
-// Dissects SetServerItemReq, GetServerItemRes and ServerItemInd telegrams
-void
-dissect_long_server_item_telegram(tvbuff_t *tvb, proto_tree *baos_payload_tree, const uint8_t start_byte_index)
+// Calculates how many bytes of an item starting at the
+// given offset are actually present in the TVB.
+// Returns the item length, cut to the end of the TVB if needed.
+int
+get_item_length_in_tvb(tvbuff_t *tvb, uint16_t item_offset, uint32_t item_length)
 {
-	// Store nr of server items in var if it's in TVB's boundaries,
-	// or assign UINT8_MAX to var if TVB is not long enough
-	const uint16_t nr_of_server_items = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	if (tvb->length <= item_offset)
+		return 0;
 
-	uint16_t server_item_id_offset = BAOS_START_INDEX + 6;
+	return MIN(item_length, tvb->length - item_offset);
+}
 
-	// Add ID of the starting server item
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_server_item_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of server items
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_server_items,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	if (nr_of_server_items == 0)
-	{
-		// Error route
-		if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
-		{
-			proto_tree_add_item(
+// Adds an ExpertInfo to telegrams which end before all
+// of the items announced in their header are complete
+void
+dissect_item_truncation(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, uint16_t nr_of_items_found, uint16_t nr_of_items, const char *item_name)
+{
+	// Without the number of items there is nothing to compare with
+	if (tvb->length < (uint16_t)(BAOS_START_INDEX + 6) || nr_of_items_found >= nr_of_items)
+		return;
+
+	proto_tree_add_expert_format(
 								baos_payload_tree,
-								hf_baos_object_server_response,
+								pinfo,
+								&ei_baos_truncated,
 								tvb,
-								server_item_id_offset,
-								1,
-								ENC_BIG_ENDIAN
+								tvb->length,
+								0,
+								"Telegram truncated: %u of %u %s complete",
+								nr_of_items_found,
+								nr_of_items,
+								item_name
 								);
-		}
+}
+
+// Builds the short list of datapoint state flags
+// shown in the summary line of a datapoint subtree.
+// Returns e.g. "valid, updated, Idle/OK".
+const char *
+get_dp_state_summary(wmem_allocator_t *scope, uint8_t dp_state)
+{
+	return wmem_strdup_printf(
+								scope,
+								"%s%s%s, %s",
+								(dp_state & 0b0001'0000) ? "valid" : "unknown",
+								(dp_state & 0b0000'1000) ? ", updated" : "",
+								(dp_state & 0b0000'0100) ? ", read request" : "",
+								val_to_str_const(dp_state & 0b0000'0011, vs_dp_state_trans_states, "Unknown")
+								);
+}
+
+// Identifies the BAOS device the telegram is exchanged with.
+// On USB, the device is identified by its bus ID and device address
+// rather than by a conversation, since the bulk IN and OUT endpoints
+// of a device may differ. Other links carry a single device.
+// Returns the key of the device in the map of device states.
+uint32_t
+get_baos_device_key(packet_info *pinfo, const usb_address_t **usb_device_addr)
+{
+	const usb_address_t *usb_addr = NULL;
+	uint32_t device_key = 0;
+
+	if (pinfo->src.type == AT_USB && pinfo->src.len == USB_ADDR_LEN &&
+		((const usb_address_t *)pinfo->src.data)->device != 0xffffffff)
+		usb_addr = (const usb_address_t *)pinfo->src.data;
+	else if (pinfo->dst.type == AT_USB && pinfo->dst.len == USB_ADDR_LEN)
+		usb_addr = (const usb_address_t *)pinfo->dst.data;
+
+	if (usb_addr)
+		device_key = (uint32_t)GUINT16_FROM_LE(usb_addr->bus_id) << 16 |
+						(GUINT32_FROM_LE(usb_addr->device) & 0xFFFF);
+
+	if (usb_device_addr)
+		*usb_device_addr = usb_addr;
+	return device_key;
+}
+
+// Looks up the state of the BAOS device the telegram is exchanged with,
+// or creates it if it's the first telegram of that device.
+baos_conv_data_t *
+get_baos_conv_data(packet_info *pinfo)
+{
+	const usb_address_t *usb_device_addr;
+	const uint32_t device_key = get_baos_device_key(pinfo, &usb_device_addr);
+
+	baos_conv_data_t *conv_data = (baos_conv_data_t *)wmem_map_lookup(baos_conv_data_map, GUINT_TO_POINTER(device_key));
+	if (!conv_data)
+	{
+		conv_data = wmem_new0(wmem_file_scope(), baos_conv_data_t);
+		conv_data->index = ++baos_device_count;
+		conv_data->dp_history = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+		conv_data->dp_names = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+		conv_data->dp_dpts = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+		conv_data->param_image = wmem_tree_new(wmem_file_scope());
+		conv_data->pending_writes = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+		conv_data->bus_load_window.dp_counts = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+		conv_data->dp_history_lru = wmem_list_new(wmem_file_scope());
+		conv_data->pending_transmissions = wmem_list_new(wmem_file_scope());
+		conv_data->name = usb_device_addr ?
+							wmem_strdup_printf(
+												wmem_file_scope(),
+												"Device %u (USB %u.%u)",
+												conv_data->index,
+												GUINT16_FROM_LE(usb_device_addr->bus_id),
+												GUINT32_FROM_LE(usb_device_addr->device)
+												) :
+							wmem_strdup_printf(wmem_file_scope(), "Device %u", conv_data->index);
+		wmem_map_insert(baos_conv_data_map, GUINT_TO_POINTER(device_key), conv_data);
 	}
-	else
+	return conv_data;
+}
+
+// Looks up the first pass results of the telegram,
+// or creates them if it's the first pass.
+baos_frame_data_t *
+get_baos_frame_data(packet_info *pinfo, baos_conv_data_t *conv_data)
+{
+	baos_frame_data_t *frame_data = (baos_frame_data_t *)p_get_proto_data(wmem_file_scope(), pinfo, proto_baos, pinfo->curr_layer_num);
+	if (!frame_data)
 	{
-		// Loop through all server items
-		for (uint16_t i = 0; i < nr_of_server_items; i++)
-		{
-			// Setup variables for current server item iteration
-			uint16_t server_item_length_offset	= server_item_id_offset + 2;
-			uint16_t server_item_data_offset	= server_item_length_offset + 1;
-			uint16_t server_item_id				= tvb_get_uint16(tvb, server_item_id_offset, ENC_BIG_ENDIAN);
-			uint8_t server_item_data_length		= tvb->length >= server_item_length_offset ?
-												tvb_get_uint8(tvb, server_item_length_offset) : UINT8_MAX;
+		frame_data = wmem_new0(wmem_file_scope(), baos_frame_data_t);
+		frame_data->frame_num = pinfo->num;
+		frame_data->abs_ts = pinfo->abs_ts;
+		p_add_proto_data(wmem_file_scope(), pinfo, proto_baos, pinfo->curr_layer_num, frame_data);
+		conv_data->mem_usage[BAOS_MEM_FRAMES] += sizeof(baos_frame_data_t) + BAOS_MEM_ENTRY_SIZE;
 
-			// Add server item ID
-			if (tvb->length >= (uint16_t)(server_item_id_offset + 2))
-			{
-				proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_server_item_id,
-									tvb,
-									server_item_id_offset,
-									2,
-									ENC_BIG_ENDIAN
-									);
-			}
-			// Add server item data length
-			if (tvb->length >= (uint16_t)(server_item_length_offset + 1))
-			{
-				proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_server_item_length,
-									tvb,
-									server_item_length_offset,
-									1,
-									ENC_BIG_ENDIAN
-									);
-			}
-			// Add server item data
-			if (tvb->length >= (uint16_t)(server_item_data_offset + server_item_data_length))
-			{
-				switch (server_item_id)
-				{
-					case HARDWARE_TYPE:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_hardware_type,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case HARDWARE_VERSION:
-					case FIRMWARE_VERSION:
-					case APPLICATION_VERSION_ETS:
-					case PROTO_VERSION_BIN:
-					case PROTO_VERSION_WEBSERVICE:
-					case PROTO_VERSION_RESTSERVICE:
-						static int* const si_version_bits[] = {
-							&hf_baos_si_version_major,
-							&hf_baos_si_version_minor,
-							NULL
-						};
-						proto_tree_add_bitmask(
-												baos_payload_tree,
-												tvb,
-												server_item_data_offset,
-												hf_baos_si_version,
-												ett_baos_payload,
-												si_version_bits,
-												ENC_BIG_ENDIAN
-												);
-						break;
-					case KNX_MANUFACTURER_CODE_DEV:
-					case KNX_MANUFACTURER_CODE_APP:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_knx_man_code,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case APPLICATION_ID_ETS:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_app_id,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case SERIAL_NUMBER:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_serial_number,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case TIME_SINCE_RESET:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_time_since_reset,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case BUS_CONNECTION_STATE:
-					case PROGRAMMING_MODE:
-					case INDICATION_SENDING:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_server_item_status,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case MAX_BUFFER_SIZE:
-					case CURRENT_BUFF_SIZE:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_buffer_size,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case LENGTH_OF_DESC_STRING:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_server_item_desc_str_len,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case BAUDRATE:
-						proto_tree_add_item(
-									baos_payload_tree,
-									hf_baos_si_baudrate,
-									tvb,
-									server_item_data_offset,
-									server_item_data_length,
-									ENC_BIG_ENDIAN
-									);
-						break;
-					case INDIVIDUAL_ADDRESS:
-						static int* const si_knx_address_bits[] = {
-							&hf_baos_si_knx_address_area,
-							&hf_baos_si_knx_address_line,
-							&hf_baos_si_knx_address_device,
-							NULL
-						};
-						proto_tree_add_bitmask(
-												baos_payload_tree,
-												tvb,
-												server_item_data_offset,
-												hf_baos_si_knx_address,
-												ett_baos_payload,
-												si_knx_address_bits,
-												ENC_BIG_ENDIAN
-												);
-						break;
-					default:
-						break;
-				}
-			}
-			server_item_id_offset += server_item_data_length + 3;
-			if(tvb->length < (uint16_t)(server_item_id_offset + 2))
-				break;
+		// The results every telegram needs to be linked with others are
+		// still kept, the analysis results of the telegram are not
+		if (is_state_budget_used_up(conv_data))
+		{
+			frame_data->is_over_budget = true;
+			conv_data->frames_over_budget++;
 		}
 	}
+	return frame_data;
 }
 
-// Dissects GetServerItemReq telegrams
+// Returns the memory used by the state of a device
+size_t
+get_baos_mem_usage(const baos_conv_data_t *conv_data)
+{
+	size_t total = 0;
+
+	for (int category = 0; category < BAOS_MEM_NR_OF_CATEGORIES; category++)
+		total += conv_data->mem_usage[category];
+	return total;
+}
+
+// Checks if the state of a device uses all of the state budget,
+// so that no further analysis results are stored for its telegrams
+bool
+is_state_budget_used_up(const baos_conv_data_t *conv_data)
+{
+	return pref_state_budget && get_baos_mem_usage(conv_data) >= (size_t)pref_state_budget * 1024;
+}
+
+// Matches a response with the unanswered request of the same subservice.
+// Since a BAOS client may only send a new request after the previous one
+// has been answered, the last request of the subservice is the match.
 void
-dissect_get_server_item_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, const uint8_t start_byte_index)
+match_baos_transaction(packet_info *pinfo, baos_info_t *baos_info)
 {
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	if (PINFO_FD_VISITED(pinfo))
+		return;
+
+	const uint8_t subservice = baos_info->subservice;
+	baos_conv_data_t *conv_data = baos_info->conv_data;
+
+	if (subservice >= GET_SERVER_ITEM_REQ_CODE && subservice <= SET_PARAMETER_BYTE_REQ_CODE)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_server_item_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		conv_data->pending_requests[subservice] = baos_info->frame_data;
 	}
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	else if (subservice >= GET_SERVER_ITEM_RES_CODE && subservice <= SET_PARAMETER_BYTE_RES_CODE)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_server_items,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		baos_frame_data_t *request_frame_data = conv_data->pending_requests[subservice & 0x0F];
+		if (request_frame_data)
+		{
+			request_frame_data->matched = baos_info->frame_data;
+			baos_info->frame_data->matched = request_frame_data;
+			conv_data->pending_requests[subservice & 0x0F] = NULL;
+		}
 	}
 }
 
-// Dissects GetDatapointDescriptionReq telegrams
+// Adds links between matching requests and responses,
+// and the response time as generated fields.
 void
-dissect_get_datapoint_desc_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+dissect_transaction_info(tvbuff_t *tvb, proto_tree *baos_payload_tree, baos_info_t *baos_info)
 {
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	const baos_frame_data_t *frame_data = baos_info->frame_data;
+	const baos_frame_data_t *matched_frame_data = frame_data->matched;
+
+	if (!matched_frame_data)
+		return;
+
+	if (baos_info->subservice & 0x80)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		nstime_t response_time;
+		nstime_delta(&response_time, &frame_data->abs_ts, &matched_frame_data->abs_ts);
+
+		proto_item *request_in_ti = proto_tree_add_uint(
+														baos_payload_tree,
+														hf_baos_request_in,
+														tvb,
+														0,
+														0,
+														matched_frame_data->frame_num
+														);
+		proto_item_set_generated(request_in_ti);
+		proto_item *response_time_ti = proto_tree_add_time(
+														baos_payload_tree,
+														hf_baos_response_time,
+														tvb,
+														0,
+														0,
+														&response_time
+														);
+		proto_item_set_generated(response_time_ti);
 	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	else
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		proto_item *response_in_ti = proto_tree_add_uint(
+														baos_payload_tree,
+														hf_baos_response_in,
+														tvb,
+														0,
+														0,
+														matched_frame_data->frame_num
+														);
+		proto_item_set_generated(response_in_ti);
 	}
 }
 
-// Dissects GetDescriptionStringReq telegrams
+// Remembers a frame of a primary station until it's acknowledged, or
+// links an acknowledgement with the frame it acknowledges. A primary
+// station only sends the next frame once the previous one has been
+// acknowledged or has timed out, so the last frame is the match.
 void
-dissect_get_desc_string_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+match_ft12_ack(packet_info *pinfo, baos_conv_data_t *conv_data, baos_frame_data_t *frame_data, uint8_t type, uint8_t control_byte)
 {
-	// Add index of the starting description string
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_desc_string,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of description strings
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	if (PINFO_FD_VISITED(pinfo))
+		return;
+
+	if (type != FT12_ACK && (control_byte & FT12_CONTROL_PRM))
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_desc_strings,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		frame_data->is_from_device = control_byte & FT12_CONTROL_DIR;
+		conv_data->unacked_frame = frame_data;
+		return;
 	}
+
+	frame_data->is_ack = true;
+	baos_frame_data_t *acked_frame_data = conv_data->unacked_frame;
+	if (!acked_frame_data)
+		return;
+
+	// Secondary frames carry a direction, unlike the single character
+	if (type == FT12_FIXED_FRAME && acked_frame_data->is_from_device == (bool)(control_byte & FT12_CONTROL_DIR))
+		return;
+
+	acked_frame_data->ack = frame_data;
+	frame_data->ack = acked_frame_data;
+	conv_data->unacked_frame = NULL;
 }
 
-// Dissects GetDatapointValueReq telegrams
+// Adds the link between a frame and its FT 1.2 acknowledgement,
+// and the acknowledgement latency as generated fields.
 void
-dissect_get_datapoint_value_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+dissect_ft12_ack_info(tvbuff_t *tvb, proto_tree *ft12_tree, const baos_frame_data_t *frame_data)
 {
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add datapoint filter code
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_dp_filter,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
-	}
+	const baos_frame_data_t *ack_frame_data = frame_data->ack;
+	nstime_t ack_latency;
+
+	if (!ack_frame_data)
+		return;
+
+	if (frame_data->is_ack)
+		nstime_delta(&ack_latency, &frame_data->abs_ts, &ack_frame_data->abs_ts);
+	else
+		nstime_delta(&ack_latency, &ack_frame_data->abs_ts, &frame_data->abs_ts);
+
+	proto_item *ack_ti = proto_tree_add_uint(
+											ft12_tree,
+											frame_data->is_ack ? hf_baos_ft12_ack_to : hf_baos_ft12_ack_in,
+											tvb,
+											0,
+											0,
+											ack_frame_data->frame_num
+											);
+	proto_item_set_generated(ack_ti);
+	proto_item *ack_latency_ti = proto_tree_add_time(
+													ft12_tree,
+													hf_baos_ft12_ack_latency,
+													tvb,
+													0,
+													0,
+													&ack_latency
+													);
+	proto_item_set_generated(ack_latency_ti);
 }
 
-// Dissects SetDatapointValueReq telegrams
-void
-dissect_set_datapoint_value_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+// Dissects FT 1.2 single character acknowledgements and fixed length
+// frames, which carry no BAOS telegram but acknowledge the frames
+// carrying them and reset or poll the link.
+// Returns the length of the frame.
+int
+dissect_ft12_link_frame(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, uint8_t type)
 {
-	// Store nr of datapoints in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	static int * const control_prm_bits[] = {
+		&hf_baos_ft12_control_dir,
+		&hf_baos_ft12_control_prm,
+		&hf_baos_ft12_control_fcb,
+		&hf_baos_ft12_control_fcv,
+		&hf_baos_ft12_control_prm_function,
+		NULL
+	};
+	static int * const control_sec_bits[] = {
+		&hf_baos_ft12_control_dir,
+		&hf_baos_ft12_control_prm,
+		&hf_baos_ft12_control_sec_function,
+		NULL
+	};
 
-	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	const int length = (type == FT12_ACK) ? 1 : FT12_FIXED_FRAME_LENGTH;
+	uint8_t control_byte = 0;
 
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	proto_item *baos_ti = proto_tree_add_item(
+												tree,
+												proto_baos,
+												tvb,
+												0,
+												length,
+												ENC_NA
+												);
+	proto_tree *baos_tree = proto_item_add_subtree(baos_ti, ett_baos);
+	proto_item *ft12_ti = proto_tree_add_item(
+												baos_tree,
+												hf_baos_ft12,
+												tvb,
+												0,
+												length,
+												ENC_NA
+												);
+	proto_tree *ft12_tree = proto_item_add_subtree(ft12_ti, ett_ft12);
+
+	if (type == FT12_ACK)
 	{
+		col_set_str(pinfo->cinfo, COL_INFO, "FT 1.2 Acknowledgement");
 		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
+							ft12_tree,
+							hf_baos_ft12_ack,
 							tvb,
-							BAOS_START_INDEX + 2,
-							2,
+							0,
+							1,
 							ENC_BIG_ENDIAN
 							);
 	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	else
 	{
+		control_byte = tvb_get_uint8(tvb, 1);
+		const bool is_primary = control_byte & FT12_CONTROL_PRM;
+
+		col_add_fstr(
+					pinfo->cinfo,
+					COL_INFO,
+					"FT 1.2 %s",
+					val_to_str_const(
+									control_byte & FT12_CONTROL_FUNCTION,
+									is_primary ? vs_ft12_prm_functions : vs_ft12_sec_functions,
+									"Unknown function"
+									)
+					);
+
 		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
+							ft12_tree,
+							hf_baos_ft12_startbyte,
 							tvb,
-							BAOS_START_INDEX + 4,
-							2,
+							0,
+							1,
 							ENC_BIG_ENDIAN
 							);
-	}
-	// Loop through all datapoints
-	for (uint16_t i = 0; i < nr_of_dps; i++)
-	{
-		// Setup variables for current server item iteration
-		uint16_t dp_command_offset	= dp_id_offset + 2;
-		uint16_t dp_length_offset	= dp_command_offset + 1;
-		uint16_t dp_value_offset	= dp_length_offset + 1;
-		uint8_t dp_length			= (tvb->length >= dp_length_offset) ?
-										tvb_get_uint8(tvb, dp_length_offset) : UINT8_MAX;
-
-		// Add datapoint ID
-		if (tvb->length >= (uint16_t)(dp_id_offset + 2))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_id,
-								tvb,
-								dp_id_offset,
-								2,
-								ENC_BIG_ENDIAN
-								);
-		}
-		// Add datapoint command
-		if (tvb->length >= (uint16_t)(dp_command_offset + 1))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_command,
-								tvb,
-								dp_command_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
-		}
-		// Add datapoint length
-		if (tvb->length >= (uint16_t)(dp_length_offset + 1))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_length,
+		proto_tree_add_bitmask(
+								ft12_tree,
 								tvb,
-								dp_length_offset,
 								1,
+								hf_baos_ft12_fixed_controlbyte,
+								ett_ft12_control,
+								is_primary ? control_prm_bits : control_sec_bits,
 								ENC_BIG_ENDIAN
 								);
-		}
-		// Add datapoint value
-		if (tvb->length >= (uint16_t)(dp_value_offset + dp_length))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_value,
-								tvb,
-								dp_value_offset,
-								dp_length,
-								ENC_BIG_ENDIAN
-								);
-		}
-		dp_id_offset += dp_length + 4;
-		if(tvb->length < (uint16_t)(dp_id_offset + 2))
-			break;
-	}
-}
-
-// Dissects GetParameterByteReq telegrams
-void
-dissect_get_parameter_byte_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
-{
-	// Add index of the starting parameter byte
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
 		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_param_byte,
+							ft12_tree,
+							hf_baos_ft12_checksum,
 							tvb,
-							BAOS_START_INDEX + 2,
 							2,
+							1,
 							ENC_BIG_ENDIAN
 							);
-	}
-	// Add number of parameter bytes
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
 		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_param_bytes,
+							ft12_tree,
+							hf_baos_ft12_endbyte,
 							tvb,
-							BAOS_START_INDEX + 4,
-							2,
+							3,
+							1,
 							ENC_BIG_ENDIAN
 							);
 	}
+
+	baos_conv_data_t *conv_data = get_baos_conv_data(pinfo);
+	baos_frame_data_t *frame_data = get_baos_frame_data(pinfo, conv_data);
+
+	match_ft12_ack(pinfo, conv_data, frame_data, type, control_byte);
+	dissect_ft12_ack_info(tvb, ft12_tree, frame_data);
+
+	// Only acknowledgements are counted, so that every latency is counted once
+	if (frame_data->is_ack && have_tap_listener(baos_ack_tap))
+	{
+		baos_ack_info_t *ack_info = wmem_new(pinfo->pool, baos_ack_info_t);
+		ack_info->conv_data = conv_data;
+		ack_info->frame_data = frame_data;
+		ack_info->is_negative = type == FT12_FIXED_FRAME && (control_byte & FT12_CONTROL_FUNCTION) == FT12_SEC_NACK;
+		tap_queue_packet(baos_ack_tap, pinfo, ack_info);
+	}
+	return length;
 }
 
-// Dissects SetParameterByteReq telegrams
-void
-dissect_set_parameter_byte_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+// Stores the value of a datapoint reported by the device.
+// Returns true if the value has changed since it was last reported,
+// or if the device flags the value as updated from the bus.
+bool
+update_dp_history(baos_conv_data_t *conv_data, tvbuff_t *tvb, packet_info *pinfo, uint16_t dp_id, uint8_t dp_state, uint16_t dp_value_offset, uint8_t dp_length)
 {
-	// Store nr of parameter bytes in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_param_bytes = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	const uint8_t stored_length = MIN(dp_length, sizeof(((baos_dp_history_t *)NULL)->value));
+	uint8_t value[sizeof(((baos_dp_history_t *)NULL)->value)];
+	bool is_changed;
 
-	uint16_t param_byte_offset = BAOS_START_INDEX + 6;
+	tvb_memcpy(tvb, value, dp_value_offset, stored_length);
 
-	// Add index of the starting parameter byte
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	baos_dp_history_t *dp_history = (baos_dp_history_t *)wmem_map_lookup(conv_data->dp_history, GUINT_TO_POINTER(dp_id));
+	if (!dp_history)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_param_byte,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		// Once the budget is used up, a new datapoint
+		// takes the place of one that went cold
+		if (is_state_budget_used_up(conv_data))
+			evict_dp_history(conv_data);
+
+		dp_history = wmem_new0(wmem_file_scope(), baos_dp_history_t);
+		dp_history->dp_id = dp_id;
+		wmem_map_insert(conv_data->dp_history, GUINT_TO_POINTER(dp_id), dp_history);
+		conv_data->mem_usage[BAOS_MEM_DP_HISTORY] += sizeof(baos_dp_history_t) + 2 * BAOS_MEM_ENTRY_SIZE;
+		is_changed = true;
 	}
-	// Add number of parameter bytes
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	else
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_param_bytes,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		is_changed = dp_history->length != dp_length ||
+						memcmp(dp_history->value, value, stored_length) != 0 ||
+						(dp_state & 0b0000'1000);
+		wmem_list_remove_frame(conv_data->dp_history_lru, dp_history->lru_frame);
 	}
-	// Loop through all parameter bytes.
-	// If it's a flush command telegram where start byte index
-	// and nr of bytes are both 0x0000, the loop won't start
-	// due to the condition in loop header being false.
-	// This is optimal, since nothing else needs to be
-	// dissected in the payload.
-	for (uint16_t i = 0; i < nr_of_param_bytes; i++)
-	{
 
-		// Add parameter byte
-		if (tvb->length >= (uint16_t)(param_byte_offset + 1))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_param_byte,
-								tvb,
-								param_byte_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
-		}
-		param_byte_offset++;
-		if(tvb->length < (uint16_t)(param_byte_offset + 1))
-			break;
-	}
+	// The most recently updated datapoint goes to the end of the list
+	wmem_list_append(conv_data->dp_history_lru, dp_history);
+	dp_history->lru_frame = wmem_list_tail(conv_data->dp_history_lru);
+
+	dp_history->last_frame = pinfo->num;
+	dp_history->state = dp_state;
+	dp_history->length = dp_length;
+	memcpy(dp_history->value, value, stored_length);
+
+	return is_changed;
 }
 
-// Dissects SetServerItemRes telegrams
+// Drops the history of the datapoint of a device that was updated least
+// recently, unless a transmission of it is still pending. An evicted
+// datapoint is treated as never seen before when it's reported again.
 void
-dissect_set_server_item_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+evict_dp_history(baos_conv_data_t *conv_data)
 {
-	// Add ID of the starting server item
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_server_item_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of server items
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_server_items,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Object server response (Notification about success or error)
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	for (wmem_list_frame_t *lru_frame = wmem_list_head(conv_data->dp_history_lru); lru_frame; lru_frame = wmem_list_frame_next(lru_frame))
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
+		baos_dp_history_t *dp_history = (baos_dp_history_t *)wmem_list_frame_data(lru_frame);
+		if (dp_history->trans_start_frame)
+			continue;
+
+		wmem_list_remove_frame(conv_data->dp_history_lru, lru_frame);
+		wmem_map_remove(conv_data->dp_history, GUINT_TO_POINTER(dp_history->dp_id));
+		wmem_free(wmem_file_scope(), dp_history);
+
+		conv_data->mem_usage[BAOS_MEM_DP_HISTORY] -= sizeof(baos_dp_history_t) + 2 * BAOS_MEM_ENTRY_SIZE;
+		conv_data->dp_history_evictions++;
+		return;
 	}
 }
 
-// Dissects GetDatapointDescriptionRes telegrams
+// Remembers the description string of a datapoint as its name.
+// Names are interned, so every distinct name is allocated only once.
 void
-dissect_get_datapoint_desc_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+store_dp_name(baos_conv_data_t *conv_data, tvbuff_t *tvb, packet_info *pinfo, uint16_t dp_id, uint16_t desc_string_offset, uint16_t desc_string_len)
 {
-	// Store nr of datapoints in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	if (PINFO_FD_VISITED(pinfo) || !desc_string_len)
+		return;
 
-	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	const char *dp_name = (const char *)tvb_get_string_enc(pinfo->pool, tvb, desc_string_offset, desc_string_len, ENC_UTF_8);
 
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	// Interned names are accounted to the device that stored them first.
+	// Names are small and kept for labeling, so they are never evicted.
+	const char *interned_dp_name = (const char *)wmem_map_lookup(baos_dp_name_pool, dp_name);
+	if (!interned_dp_name)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		interned_dp_name = wmem_strdup(wmem_file_scope(), dp_name);
+		wmem_map_insert(baos_dp_name_pool, interned_dp_name, (void *)interned_dp_name);
+		conv_data->mem_usage[BAOS_MEM_DP_NAMES] += strlen(interned_dp_name) + 1 + BAOS_MEM_ENTRY_SIZE;
 	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add object server response if it's an error telegram
-	if (!nr_of_dps && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Loop through all datapoints
-	for (uint16_t i = 0; i < nr_of_dps; i++)
-	{
-		// Setup variables for current server item iteration
-		uint16_t dp_value_type_offset	= dp_id_offset + 2;
-		uint16_t dp_config_flags_offset	= dp_value_type_offset + 1;
-		uint16_t dp_dpt_offset			= dp_config_flags_offset + 1;
 
-		// Add datapoint ID
-		if (tvb->length >= (uint16_t)(dp_id_offset + 2))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_id,
-								tvb,
-								dp_id_offset,
-								2,
-								ENC_BIG_ENDIAN
-								);
-		}
-		// Add datapoint value type
-		if (tvb->length >= (uint16_t)(dp_id_offset + 2))
+	baos_dp_name_t *prev_dp_name = (baos_dp_name_t *)wmem_map_lookup(conv_data->dp_names, GUINT_TO_POINTER(dp_id));
+	if (prev_dp_name && prev_dp_name->name == interned_dp_name)
+		return;
+	if (!prev_dp_name)
+		conv_data->mem_usage[BAOS_MEM_DP_NAMES] += BAOS_MEM_ENTRY_SIZE;
+
+	// A renamed datapoint keeps its earlier names for the frames before
+	baos_dp_name_t *new_dp_name = wmem_new(wmem_file_scope(), baos_dp_name_t);
+	new_dp_name->name = interned_dp_name;
+	new_dp_name->first_frame = pinfo->num;
+	new_dp_name->prev = prev_dp_name;
+	wmem_map_insert(conv_data->dp_names, GUINT_TO_POINTER(dp_id), new_dp_name);
+	conv_data->mem_usage[BAOS_MEM_DP_NAMES] += sizeof(baos_dp_name_t);
+}
+
+// Parses the first decimal number of a catalog field, skipping
+// any prefix like "DPT-" or "DPST-". Returns false if there is none.
+bool
+parse_dp_catalog_number(const char *field, const char *field_end, uint32_t *number)
+{
+	while (field < field_end && !g_ascii_isdigit(*field))
+		field++;
+
+	if (field == field_end)
+		return false;
+
+	*number = 0;
+	while (field < field_end && g_ascii_isdigit(*field) && *number <= UINT16_MAX)
+		*number = *number * 10 + (uint32_t)(*field++ - '0');
+
+	return true;
+}
+
+// Parses a line of the datapoint catalog file, which has the format
+// <DP ID>,<name>,<DPT>,<value type>. Fields may also be separated by
+// semicolons, the name may be quoted, and DPT and value type are optional.
+// Empty lines, comments starting with '#' and header lines are skipped.
+void
+parse_dp_catalog_line(const char *content, const char *line, const char *line_end)
+{
+	const char *fields[4];
+	const char *field_ends[4];
+	unsigned nr_of_fields = 0;
+	uint32_t dp_id;
+
+	// Split line into fields
+	const char *field = line;
+	while (nr_of_fields < array_length(fields))
+	{
+		const char *field_end = field;
+		bool is_quoted = false;
+		while (field_end < line_end && (is_quoted || (*field_end != ',' && *field_end != ';')))
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_value_type,
-								tvb,
-								dp_value_type_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
+			if (*field_end == '"')
+				is_quoted = !is_quoted;
+			field_end++;
 		}
-		// Add datapoint config flags
-		if (tvb->length >= (uint16_t)(dp_config_flags_offset + 1))
+
+		// Trim whitespace and quotes
+		while (field < field_end && (g_ascii_isspace(*field) || *field == '"'))
+			field++;
+		const char *trimmed_field_end = field_end;
+		while (trimmed_field_end > field && (g_ascii_isspace(trimmed_field_end[-1]) || trimmed_field_end[-1] == '"'))
+			trimmed_field_end--;
+
+		fields[nr_of_fields] = field;
+		field_ends[nr_of_fields] = trimmed_field_end;
+		nr_of_fields++;
+
+		if (field_end >= line_end)
+			break;
+		field = field_end + 1;
+	}
+
+	// Skip empty lines, comments and header lines
+	if (fields[0] == field_ends[0] || *fields[0] == '#' || !g_ascii_isdigit(*fields[0]))
+		return;
+	if (!parse_dp_catalog_number(fields[0], field_ends[0], &dp_id) || dp_id > UINT16_MAX)
+		return;
+
+	// Grow the dense array, unlisted datapoints stay empty.
+	// Its allocation is doubled, so that catalogs listing the
+	// datapoints in ascending order don't reallocate on every line.
+	if (dp_id >= baos_dp_catalog.nr_of_entries)
+	{
+		const uint32_t nr_of_entries = dp_id + 1;
+		if (nr_of_entries > baos_dp_catalog.nr_of_allocated_entries)
 		{
-			static int* const config_flags_bits[] = {
-				&hf_baos_dp_config_trans_prio,
-				&hf_baos_dp_config_dp_comm,
-				&hf_baos_dp_config_read_from_bus,
-				&hf_baos_dp_config_write_from_bus,
-				&hf_baos_dp_config_read_on_init,
-				&hf_baos_dp_config_trans_to_bus,
-				&hf_baos_dp_config_update_on_res,
-				NULL
-			};
-			proto_tree_add_bitmask(
-									baos_payload_tree,
-									tvb,
-									dp_config_flags_offset,
-									hf_baos_dp_config_flags,
-									ett_baos_payload,
-									config_flags_bits,
-									ENC_BIG_ENDIAN
-									);
+			baos_dp_catalog.nr_of_allocated_entries = MIN(MAX(nr_of_entries, 2 * baos_dp_catalog.nr_of_allocated_entries), UINT16_MAX + 1);
+			baos_dp_catalog.entries = g_renew(baos_dp_catalog_entry_t, baos_dp_catalog.entries, baos_dp_catalog.nr_of_allocated_entries);
 		}
-		// Add datapoint type
-		if (tvb->length >= (uint16_t)(dp_dpt_offset + 1))
+		for (uint32_t i = baos_dp_catalog.nr_of_entries; i < nr_of_entries; i++)
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_dpt,
-								tvb,
-								dp_dpt_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
+			baos_dp_catalog.entries[i].name_offset = 0;
+			baos_dp_catalog.entries[i].name_length = 0;
+			baos_dp_catalog.entries[i].dpt = UNKNOWN_DPT;
+			baos_dp_catalog.entries[i].value_type = UINT8_MAX;
 		}
-		dp_id_offset += 5;
-		if(tvb->length < (uint16_t)(dp_id_offset + 2))
-			break;
+		baos_dp_catalog.nr_of_entries = nr_of_entries;
+	}
+
+	baos_dp_catalog_entry_t *entry = &baos_dp_catalog.entries[dp_id];
+
+	// Add name
+	if (nr_of_fields > 1)
+	{
+		entry->name_offset = (uint32_t)(fields[1] - content);
+		entry->name_length = (uint16_t)MIN(field_ends[1] - fields[1], UINT16_MAX);
+	}
+	// Add DPT, given by its main number
+	uint32_t dpt;
+	if (nr_of_fields > 2 && parse_dp_catalog_number(fields[2], field_ends[2], &dpt))
+	{
+		if (dpt >= DPT1 && dpt <= DPT19)
+			entry->dpt = (uint8_t)dpt;
+		else if (dpt == 20)
+			entry->dpt = DPT20;
+		else if (dpt == 232)
+			entry->dpt = DPT232;
+		else if (dpt == 251)
+			entry->dpt = DPT251;
 	}
+	// Add value type code
+	uint32_t value_type;
+	if (nr_of_fields > 3 && parse_dp_catalog_number(fields[3], field_ends[3], &value_type) && value_type <= DP_VT_14BYTE)
+		entry->value_type = (uint8_t)value_type;
 }
 
-// Dissects GetDescriptionStringRes telegrams
-void
-dissect_get_desc_string_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+// Loads the datapoint catalog file set in the preferences.
+// The file is memory-mapped and only reloaded if it has changed.
+// Returns true if the catalog has been reloaded or dropped.
+bool
+load_dp_catalog(bool report_errors)
 {
-	// Store nr of description strings in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_desc_strings = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	ws_statb64 file_stat;
+	const bool has_file_name = pref_dp_catalog_file && *pref_dp_catalog_file;
+	const bool has_file = has_file_name && ws_stat64(pref_dp_catalog_file, &file_stat) == 0;
 
-	uint16_t desc_string_len_offset = BAOS_START_INDEX + 6;
+	// Keep the loaded catalog if the file has not changed
+	if (has_file && baos_dp_catalog.file_name &&
+		strcmp(baos_dp_catalog.file_name, pref_dp_catalog_file) == 0 &&
+		baos_dp_catalog.file_size == (int64_t)file_stat.st_size &&
+		baos_dp_catalog.file_mtime == file_stat.st_mtime)
+		return false;
 
-	// Add ID of start desc string
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	// Drop the loaded catalog
+	g_free(baos_dp_catalog.entries);
+	g_free(baos_dp_catalog.file_name);
+	if (baos_dp_catalog.mapped_file)
+		g_mapped_file_unref(baos_dp_catalog.mapped_file);
+	memset(&baos_dp_catalog, 0, sizeof(baos_dp_catalog));
+
+	if (!has_file)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_desc_string,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		if (has_file_name && report_errors)
+			report_open_failure(pref_dp_catalog_file, errno, false);
+		return true;
 	}
-	// Add number of desc strings
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	if ((uint64_t)file_stat.st_size > UINT32_MAX)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_desc_strings,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		if (report_errors)
+			report_failure("BAOS datapoint catalog \"%s\" is too large", pref_dp_catalog_file);
+		return true;
 	}
-	// Add object server response if it's an error telegram
-	if (!nr_of_desc_strings && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+
+	GError *error = NULL;
+	GMappedFile *mapped_file = g_mapped_file_new(pref_dp_catalog_file, false, &error);
+	if (!mapped_file)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
+		if (report_errors)
+			report_failure("Could not map BAOS datapoint catalog \"%s\": %s", pref_dp_catalog_file, error->message);
+		g_error_free(error);
+		return true;
 	}
-	// Loop through all desc strings
-	for (uint16_t i = 0; i < nr_of_desc_strings; i++)
+
+	baos_dp_catalog.file_name = g_strdup(pref_dp_catalog_file);
+	baos_dp_catalog.mapped_file = mapped_file;
+	baos_dp_catalog.file_size = (int64_t)file_stat.st_size;
+	baos_dp_catalog.file_mtime = file_stat.st_mtime;
+
+	// Parse the catalog line by line
+	const char *content = g_mapped_file_get_contents(mapped_file);
+	const char *content_end = content + g_mapped_file_get_length(mapped_file);
+	const char *line = content;
+	while (line && line < content_end)
 	{
-		uint16_t desc_string_offset = desc_string_len_offset + 2;
+		const char *line_end = (const char *)memchr(line, '\n', content_end - line);
+		if (!line_end)
+			line_end = content_end;
 
-		// Store description string length in var if it's in TVB's boundaries,
-		// or assign UINT16_MAX to var if TVB is not long enough
-		const uint16_t desc_string_len = (tvb->length >= (uint16_t)(desc_string_len_offset + 2)) ?
-											tvb_get_uint16(tvb, desc_string_len_offset, ENC_BIG_ENDIAN) : UINT16_MAX;
-		// Add desc string len
-		if (tvb->length >= (uint16_t)(desc_string_len_offset + 2))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_desc_string_len,
-								tvb,
-								desc_string_len_offset,
-								2,
-								ENC_BIG_ENDIAN
-								);
-		}
-		// Add desc string
-		if (tvb->length >= (uint16_t)(desc_string_offset + desc_string_len))
-		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_desc_string,
-								tvb,
-								desc_string_offset,
-								desc_string_len,
-								ENC_BIG_ENDIAN
-								);
-		}
-		desc_string_len_offset += desc_string_len + 2;
-		if(tvb->length < (uint16_t)(desc_string_len_offset + 2))
-			break;
+		parse_dp_catalog_line(content, line, line_end);
+		line = line_end + 1;
 	}
+
+	return true;
 }
 
-// Dissects GetDatapointValueRes telegrams
+// Returns the type of the per-datapoint value field for a DPT:
+// double for float DPTs, integers for everything else that is numeric,
+// or FT_NONE if values of the DPT are not numeric
+enum ftenum
+get_dp_value_ftype(uint8_t dpt)
+{
+	switch (dpt)
+	{
+		case DPT9: case DPT14:
+			return FT_DOUBLE;
+		case DPT6: case DPT8: case DPT13:
+			return FT_INT32;
+		case DPT1: case DPT5: case DPT7: case DPT12: case DPT17: case DPT20:
+			return FT_UINT32;
+		default:
+			return FT_NONE;
+	}
+}
+
+// Registers a value field named baos.dp_value.dp_<ID> for every datapoint
+// of the catalog with a numeric DPT, replacing the fields of the previous
+// catalog. This keeps the field names stable across captures.
 void
-dissect_get_datapoint_value_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+register_dp_value_fields(void)
 {
-	// Store nr of datapoints in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	// Deregister the fields of the previous catalog
+	if (dp_value_hf)
+	{
+		for (unsigned i = 0; i < nr_of_dp_value_hf; i++)
+			proto_deregister_field(proto_baos, *dp_value_hf[i].p_id);
+		proto_add_deregistered_data(dp_value_hf);
+		dp_value_hf = NULL;
+		nr_of_dp_value_hf = 0;
+	}
+	// The deregistered fields still point into the IDs until
+	// they are freed, so the IDs are freed along with them
+	if (dp_value_hf_ids)
+		proto_add_deregistered_data(dp_value_hf_ids);
+	dp_value_hf_ids = NULL;
+	nr_of_dp_value_hf_ids = 0;
 
-	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	if (!baos_dp_catalog.nr_of_entries)
+		return;
 
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	dp_value_hf_ids = g_new0(int, baos_dp_catalog.nr_of_entries);
+	nr_of_dp_value_hf_ids = baos_dp_catalog.nr_of_entries;
+	dp_value_hf = g_new0(hf_register_info, baos_dp_catalog.nr_of_entries);
+
+	for (uint32_t dp_id = 0; dp_id < baos_dp_catalog.nr_of_entries; dp_id++)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		const enum ftenum ftype = get_dp_value_ftype(baos_dp_catalog.entries[dp_id].dpt);
+		if (ftype == FT_NONE)
+			continue;
+
+		char *dp_name = get_dp_catalog_name(NULL, (uint16_t)dp_id);
+		hf_register_info *hf = &dp_value_hf[nr_of_dp_value_hf++];
+
+		dp_value_hf_ids[dp_id] = -1;
+		hf->p_id = &dp_value_hf_ids[dp_id];
+		hf->hfinfo.name = dp_name ? g_strdup_printf("%s (DP %u)", dp_name, dp_id) : g_strdup_printf("DP %u", dp_id);
+		hf->hfinfo.abbrev = g_strdup_printf("baos.dp_value.dp_%u", dp_id);
+		hf->hfinfo.type = ftype;
+		hf->hfinfo.display = (ftype == FT_DOUBLE) ? BASE_NONE : BASE_DEC;
+		hf->hfinfo.strings = NULL;
+		hf->hfinfo.bitmask = 0;
+		hf->hfinfo.blurb = g_strdup_printf("Value of datapoint %u, decoded according to the DPT from the catalog", dp_id);
+		HFILL_INIT(*hf);
+		wmem_free(NULL, dp_name);
 	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+
+	proto_register_field_array(proto_baos, dp_value_hf, nr_of_dp_value_hf);
+}
+
+// Returns the value field of a datapoint, or 0 if it has none
+int
+get_dp_value_hf(uint16_t dp_id)
+{
+	if (dp_id >= nr_of_dp_value_hf_ids)
+		return 0;
+	return dp_value_hf_ids[dp_id];
+}
+
+// Returns the catalog entry of a datapoint, or NULL if it is not listed
+const baos_dp_catalog_entry_t *
+get_dp_catalog_entry(uint16_t dp_id)
+{
+	if (dp_id >= baos_dp_catalog.nr_of_entries)
+		return NULL;
+	return &baos_dp_catalog.entries[dp_id];
+}
+
+// Stores the DPT a device reports for a datapoint in GetDatapointDescription.Res
+void
+store_dp_dpt(baos_conv_data_t *conv_data, packet_info *pinfo, uint16_t dp_id, uint8_t dpt)
+{
+	if (PINFO_FD_VISITED(pinfo) || dpt == 0 || dpt == UNKNOWN_DPT)
+		return;
+
+	if (!wmem_map_contains(conv_data->dp_dpts, GUINT_TO_POINTER(dp_id)))
+		conv_data->mem_usage[BAOS_MEM_DP_NAMES] += BAOS_MEM_ENTRY_SIZE;
+	wmem_map_insert(conv_data->dp_dpts, GUINT_TO_POINTER(dp_id), GUINT_TO_POINTER(dpt));
+}
+
+// Returns the DPT of a datapoint from the catalog, or the one
+// the device has reported if the catalog doesn't list it.
+// Returns UNKNOWN_DPT if neither is known.
+uint8_t
+get_dp_dpt(const baos_conv_data_t *conv_data, uint16_t dp_id, bool *is_dpt_from_device)
+{
+	const baos_dp_catalog_entry_t *entry = get_dp_catalog_entry(dp_id);
+
+	*is_dpt_from_device = false;
+	if (entry && entry->dpt != UNKNOWN_DPT)
+		return entry->dpt;
+
+	const uint8_t dpt = (uint8_t)GPOINTER_TO_UINT(wmem_map_lookup(conv_data->dp_dpts, GUINT_TO_POINTER(dp_id)));
+	if (!dpt)
+		return UNKNOWN_DPT;
+	*is_dpt_from_device = true;
+	return dpt;
+}
+
+// Returns the minimum length of a value of a DPT
+uint8_t
+get_dpt_min_length(uint8_t dpt)
+{
+	switch (dpt)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		case DPT7: case DPT8: case DPT9:
+			return 2;
+		case DPT10: case DPT11: case DPT232:
+			return 3;
+		case DPT12: case DPT13: case DPT14:
+			return 4;
+		case DPT251:
+			return 6;
+		case DPT19:
+			return 8;
+		default:
+			return 1;
 	}
-	// Add object server response if it's an error telegram
-	if (!nr_of_dps && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+}
+
+// Decodes the value of a datapoint with a numeric DPT.
+// Returns false if values of the DPT are not numeric.
+bool
+decode_dp_value_numeric(tvbuff_t *tvb, uint8_t dpt, uint16_t dp_value_offset, double *value)
+{
+	switch (dpt)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
+		case DPT1:
+			*value = tvb_get_uint8(tvb, dp_value_offset) & 0x01;
+			return true;
+		case DPT5:
+		case DPT20:
+			*value = tvb_get_uint8(tvb, dp_value_offset);
+			return true;
+		case DPT17:
+			*value = tvb_get_uint8(tvb, dp_value_offset) & 0x3F;
+			return true;
+		case DPT6:
+			*value = (int8_t)tvb_get_uint8(tvb, dp_value_offset);
+			return true;
+		case DPT7:
+			*value = tvb_get_uint16(tvb, dp_value_offset, ENC_BIG_ENDIAN);
+			return true;
+		case DPT8:
+			*value = (int16_t)tvb_get_uint16(tvb, dp_value_offset, ENC_BIG_ENDIAN);
+			return true;
+		case DPT9:
+		{
+			// KNX 2 byte float: 0.01 * M * 2^E, with a 12 bit two's complement mantissa
+			const uint16_t raw_value = tvb_get_uint16(tvb, dp_value_offset, ENC_BIG_ENDIAN);
+			const int mantissa = (raw_value & 0x8000) ? (int)(raw_value & 0x07FF) - 2048 : (int)(raw_value & 0x07FF);
+			*value = 0.01 * mantissa * (double)(1 << ((raw_value >> 11) & 0x0F));
+			return true;
+		}
+		case DPT12:
+			*value = tvb_get_uint32(tvb, dp_value_offset, ENC_BIG_ENDIAN);
+			return true;
+		case DPT13:
+			*value = (int32_t)tvb_get_uint32(tvb, dp_value_offset, ENC_BIG_ENDIAN);
+			return true;
+		case DPT14:
+			*value = tvb_get_ntohieee_float(tvb, dp_value_offset);
+			return true;
+		default:
+			return false;
 	}
-	// Loop through all datapoints
-	for (uint16_t i = 0; i < nr_of_dps; i++)
+}
+
+// Decodes the value of a datapoint according to its DPT from the catalog,
+// or the DPT reported by the device if the catalog doesn't list one.
+// The DPT and numeric value are kept from the first pass.
+// Returns the decoded value as text, or NULL if the DPT is unknown
+// or the value is too short for it.
+const char *
+dissect_dp_value_typed(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_value_offset, uint8_t dp_length)
+{
+	const baos_dp_catalog_entry_t *entry = get_dp_catalog_entry(dp_id);
+	baos_frame_data_t *frame_data = baos_info->frame_data;
+	const baos_dp_decoded_t *decoded = frame_data->dp_decoded ?
+										(const baos_dp_decoded_t *)wmem_map_lookup(frame_data->dp_decoded, GUINT_TO_POINTER(dp_id)) : NULL;
+
+	// Use the DPT known on the first pass, which later
+	// GetDatapointDescription.Res telegrams don't change
+	bool is_dpt_from_device = false;
+	uint8_t dpt = UNKNOWN_DPT;
+	if (decoded)
 	{
-		// Setup variables for current server item iteration
-		uint16_t dp_state_offset	= dp_id_offset + 2;
-		uint16_t dp_length_offset	= dp_state_offset + 1;
-		uint16_t dp_value_offset	= dp_length_offset + 1;
-		uint8_t dp_length			= (tvb->length >= dp_length_offset) ?
-										tvb_get_uint8(tvb, dp_length_offset) : UINT8_MAX;
+		dpt = decoded->dpt;
+		is_dpt_from_device = decoded->is_dpt_from_device;
+	}
+	else if (!PINFO_FD_VISITED(pinfo) && !frame_data->is_over_budget)
+		dpt = get_dp_dpt(baos_info->conv_data, dp_id, &is_dpt_from_device);
+	else if (entry)
+		dpt = entry->dpt;
 
-		// Add datapoint ID
-		if (tvb->length >= (uint16_t)(dp_id_offset + 2))
+	const bool has_value_type = entry && entry->value_type != UINT8_MAX;
+	if (dpt == UNKNOWN_DPT && !has_value_type)
+		return NULL;
+
+	// Add what the catalog or the device tells about the datapoint
+	if (dpt != UNKNOWN_DPT)
+	{
+		proto_item *dpt_ti = proto_tree_add_uint(dp_tree, is_dpt_from_device ? hf_baos_dp_device_dpt : hf_baos_dp_catalog_dpt, tvb, 0, 0, dpt);
+		proto_item_set_generated(dpt_ti);
+	}
+	if (has_value_type)
+	{
+		proto_item *value_type_ti = proto_tree_add_uint(dp_tree, hf_baos_dp_catalog_value_type, tvb, 0, 0, entry->value_type);
+		proto_item_set_generated(value_type_ti);
+	}
+
+	const uint8_t min_length = get_dpt_min_length(dpt);
+	if (dpt == UNKNOWN_DPT || dp_length < min_length)
+		return NULL;
+
+	// Decode numeric values once, on the first pass
+	double numeric_value = 0;
+	bool is_numeric;
+	if (decoded)
+	{
+		numeric_value = decoded->numeric_value;
+		is_numeric = get_dp_value_ftype(dpt) != FT_NONE;
+	}
+	else
+	{
+		is_numeric = decode_dp_value_numeric(tvb, dpt, dp_value_offset, &numeric_value);
+		if (!PINFO_FD_VISITED(pinfo) && !frame_data->is_over_budget)
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_id,
-								tvb,
-								dp_id_offset,
-								2,
-								ENC_BIG_ENDIAN
-								);
+			if (!frame_data->dp_decoded)
+				frame_data->dp_decoded = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+			baos_dp_decoded_t *new_decoded = wmem_new(wmem_file_scope(), baos_dp_decoded_t);
+			new_decoded->numeric_value = numeric_value;
+			new_decoded->dpt = dpt;
+			new_decoded->is_dpt_from_device = is_dpt_from_device;
+			wmem_map_insert(frame_data->dp_decoded, GUINT_TO_POINTER(dp_id), new_decoded);
+			baos_info->conv_data->mem_usage[BAOS_MEM_FRAMES] += sizeof(baos_dp_decoded_t) + BAOS_MEM_ENTRY_SIZE;
 		}
-		// Add datapoint state
-		if (tvb->length >= (uint16_t)(dp_state_offset + 1))
+	}
+
+	static const char *weekdays[] = { "", "Mon ", "Tue ", "Wed ", "Thu ", "Fri ", "Sat ", "Sun " };
+	proto_item *value_ti = NULL;
+	const char *value_text = NULL;
+	uint8_t value_length = min_length;
+	const uint8_t first_byte = tvb_get_uint8(tvb, dp_value_offset);
+
+	switch (dpt)
+	{
+		case DPT1:
+			value_ti = proto_tree_add_boolean(dp_tree, hf_baos_dp_value_bool, tvb, dp_value_offset, 1, numeric_value != 0);
+			value_text = numeric_value != 0 ? "true" : "false";
+			break;
+		case DPT2:
+			value_text = wmem_strdup_printf(pinfo->pool, "control %u, value %u", (first_byte >> 1) & 0x01, first_byte & 0x01);
+			break;
+		case DPT3:
+			value_text = wmem_strdup_printf(pinfo->pool, "%s, step code %u", (first_byte & 0x08) ? "increase" : "decrease", first_byte & 0x07);
+			break;
+		case DPT4:
+			value_text = tvb_format_text(pinfo->pool, tvb, dp_value_offset, 1);
+			break;
+		case DPT5:
+		case DPT7:
+		case DPT12:
+		case DPT20:
+			value_ti = proto_tree_add_uint(dp_tree, hf_baos_dp_value_unsigned, tvb, dp_value_offset, min_length, (uint32_t)numeric_value);
+			value_text = wmem_strdup_printf(pinfo->pool, "%u", (uint32_t)numeric_value);
+			break;
+		case DPT17:
+			value_ti = proto_tree_add_uint(dp_tree, hf_baos_dp_value_unsigned, tvb, dp_value_offset, 1, (uint32_t)numeric_value);
+			value_text = wmem_strdup_printf(pinfo->pool, "scene %u", (uint32_t)numeric_value);
+			break;
+		case DPT18:
+			value_text = wmem_strdup_printf(pinfo->pool, "%s scene %u", (first_byte & 0x80) ? "learn" : "activate", first_byte & 0x3F);
+			break;
+		case DPT6:
+		case DPT8:
+		case DPT13:
+			value_ti = proto_tree_add_int(dp_tree, hf_baos_dp_value_signed, tvb, dp_value_offset, min_length, (int32_t)numeric_value);
+			value_text = wmem_strdup_printf(pinfo->pool, "%d", (int32_t)numeric_value);
+			break;
+		case DPT9:
+			value_ti = proto_tree_add_double(dp_tree, hf_baos_dp_value_float, tvb, dp_value_offset, 2, numeric_value);
+			value_text = wmem_strdup_printf(pinfo->pool, "%.2f", numeric_value);
+			break;
+		case DPT10:
 		{
-			static int* const dp_state_bits[] = {
-				&hf_baos_dp_state_valid,
-				&hf_baos_dp_state_update,
-				&hf_baos_dp_state_read_req,
-				&hf_baos_dp_state_trans,
-				NULL
-			};
-			proto_tree_add_bitmask(
-									baos_payload_tree,
-									tvb,
-									dp_state_offset,
-									hf_baos_dp_state,
-									ett_baos_payload,
-									dp_state_bits,
-									ENC_BIG_ENDIAN
-									);
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"%s%02u:%02u:%02u",
+											weekdays[first_byte >> 5],
+											first_byte & 0x1F,
+											tvb_get_uint8(tvb, dp_value_offset + 1) & 0x3F,
+											tvb_get_uint8(tvb, dp_value_offset + 2) & 0x3F
+											);
+			break;
 		}
-		// Add datapoint length
-		if (tvb->length >= (uint16_t)(dp_length_offset + 1))
+		case DPT11:
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_length,
-								tvb,
-								dp_length_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
+			const unsigned year = tvb_get_uint8(tvb, dp_value_offset + 2) & 0x7F;
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"%04u-%02u-%02u",
+											year < 90 ? 2000 + year : 1900 + year,
+											tvb_get_uint8(tvb, dp_value_offset + 1) & 0x0F,
+											first_byte & 0x1F
+											);
+			break;
 		}
-		// Add datapoint value
-		if (tvb->length >= (uint16_t)(dp_value_offset + dp_length))
+		case DPT14:
+			value_ti = proto_tree_add_double(dp_tree, hf_baos_dp_value_float, tvb, dp_value_offset, 4, numeric_value);
+			value_text = wmem_strdup_printf(pinfo->pool, "%g", numeric_value);
+			break;
+		case DPT16:
+			value_length = MIN(dp_length, 14);
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"\"%s\"",
+											tvb_get_string_enc(pinfo->pool, tvb, dp_value_offset, value_length, ENC_ISO_8859_1)
+											);
+			break;
+		case DPT19:
+			// Year counted from 1900, followed by month, day, weekday and
+			// hour, minutes, seconds and two bytes of quality flags
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"%s%04u-%02u-%02u %02u:%02u:%02u",
+											weekdays[tvb_get_uint8(tvb, dp_value_offset + 3) >> 5],
+											1900 + first_byte,
+											tvb_get_uint8(tvb, dp_value_offset + 1) & 0x0F,
+											tvb_get_uint8(tvb, dp_value_offset + 2) & 0x1F,
+											tvb_get_uint8(tvb, dp_value_offset + 3) & 0x1F,
+											tvb_get_uint8(tvb, dp_value_offset + 4) & 0x3F,
+											tvb_get_uint8(tvb, dp_value_offset + 5) & 0x3F
+											);
+			break;
+		case DPT232:
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"#%02X%02X%02X",
+											first_byte,
+											tvb_get_uint8(tvb, dp_value_offset + 1),
+											tvb_get_uint8(tvb, dp_value_offset + 2)
+											);
+			break;
+		case DPT251:
+			// Red, green, blue and white, followed by a reserved byte
+			// and the flags telling which of the four are valid
+			value_text = wmem_strdup_printf(
+											pinfo->pool,
+											"#%02X%02X%02X, white %u",
+											first_byte,
+											tvb_get_uint8(tvb, dp_value_offset + 1),
+											tvb_get_uint8(tvb, dp_value_offset + 2),
+											tvb_get_uint8(tvb, dp_value_offset + 3)
+											);
+			break;
+		default:
+			return NULL;
+	}
+
+	// DPTs without a numeric representation get a text field
+	if (!is_numeric)
+		value_ti = proto_tree_add_string(dp_tree, hf_baos_dp_value_text, tvb, dp_value_offset, value_length, value_text);
+	proto_item_set_generated(value_ti);
+
+	// Numeric values also get the field of their datapoint, which IO graphs can plot
+	const int dp_value_hf = get_dp_value_hf(dp_id);
+	if (is_numeric && dp_value_hf > 0)
+	{
+		proto_item *dp_value_ti;
+		switch (proto_registrar_get_ftype(dp_value_hf))
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_dp_value,
-								tvb,
-								dp_value_offset,
-								dp_length,
-								ENC_BIG_ENDIAN
-								);
+			case FT_DOUBLE:
+				dp_value_ti = proto_tree_add_double(dp_tree, dp_value_hf, tvb, dp_value_offset, min_length, numeric_value);
+				break;
+			case FT_INT32:
+				dp_value_ti = proto_tree_add_int(dp_tree, dp_value_hf, tvb, dp_value_offset, min_length, (int32_t)numeric_value);
+				break;
+			default:
+				dp_value_ti = proto_tree_add_uint(dp_tree, dp_value_hf, tvb, dp_value_offset, min_length, (uint32_t)numeric_value);
+				break;
 		}
-		dp_id_offset += dp_length + 4;
-		if(tvb->length < (uint16_t)(dp_id_offset + 2))
-			break;
+		proto_item_set_generated(dp_value_ti);
 	}
+
+	return value_text;
 }
 
-// Dissects SetDatapointValueRes telegrams
+// Returns the name of a datapoint from the catalog, or NULL if it has none
+char *
+get_dp_catalog_name(wmem_allocator_t *scope, uint16_t dp_id)
+{
+	const baos_dp_catalog_entry_t *catalog_entry = get_dp_catalog_entry(dp_id);
+
+	if (!catalog_entry || !catalog_entry->name_length)
+		return NULL;
+	return wmem_strndup(
+						scope,
+						g_mapped_file_get_contents(baos_dp_catalog.mapped_file) + catalog_entry->name_offset,
+						catalog_entry->name_length
+						);
+}
+
+// Returns the name of a datapoint if the device has told us about it
+// or the catalog lists it. Names reported by the device take precedence.
+const char *
+get_dp_name(packet_info *pinfo, const baos_conv_data_t *conv_data, uint16_t dp_id)
+{
+	const baos_dp_name_t *dp_name = (const baos_dp_name_t *)wmem_map_lookup(conv_data->dp_names, GUINT_TO_POINTER(dp_id));
+
+	// Skip names learned after the frame
+	while (dp_name && dp_name->first_frame > pinfo->num)
+		dp_name = dp_name->prev;
+
+	if (dp_name)
+		return dp_name->name;
+	return get_dp_catalog_name(pinfo->pool, dp_id);
+}
+
+// Returns the label of a datapoint, which includes its name if known
+const char *
+get_dp_label(packet_info *pinfo, const baos_conv_data_t *conv_data, uint16_t dp_id)
+{
+	const char *dp_name = get_dp_name(pinfo, conv_data, dp_id);
+
+	if (dp_name)
+		return wmem_strdup_printf(pinfo->pool, "%s (DP %u)", dp_name, dp_id);
+	return wmem_strdup_printf(pinfo->pool, "DP %u", dp_id);
+}
+
+// Lists the i-th datapoint of a telegram in the info column.
+// Only the first few datapoints are listed, followed by an ellipsis.
 void
-dissect_set_datapoint_value_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+add_dp_label_to_col_info(packet_info *pinfo, uint16_t i, const char *dp_label)
 {
-	// Add ID of the starting datapoint
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_dp_id,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of datapoints
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_dps,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Object server response (Notification about success or error)
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
-	}
+	if (i < BAOS_COL_INFO_MAX_DPS)
+		col_append_fstr(pinfo->cinfo, COL_INFO, "%s %s", i ? "," : ":", dp_label);
+	else if (i == BAOS_COL_INFO_MAX_DPS)
+		col_append_str(pinfo->cinfo, COL_INFO, ", " UTF8_HORIZONTAL_ELLIPSIS);
 }
 
-// Dissects GetParameterByteRes telegrams
+// Hands a datapoint value found in the telegram to the taps
 void
-dissect_get_parameter_byte_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+add_dp_value(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t state, const char *value)
 {
-	// Store nr of parameter bytes in var if it's in TVB's boundaries,
-	// or assign UINT16_MAX to var if TVB is not long enough
-	const uint16_t nr_of_param_bytes = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
-										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	if (!baos_info->dp_values)
+		baos_info->dp_values = wmem_array_new(pinfo->pool, sizeof(baos_dp_value_t));
 
-	uint16_t param_byte_offset = BAOS_START_INDEX + 6;
+	const baos_dp_value_t dp_value = { dp_id, state, value };
+	wmem_array_append_one(baos_info->dp_values, dp_value);
+}
 
-	// Add index of the starting parameter byte
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
-	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_param_byte,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
-	}
-	// Add number of parameter bytes
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+// Updates a parameter byte image with the parameter bytes of a telegram.
+// If prev_writes is set, it receives the frame each byte was last written in.
+// Returns the number of parameter bytes added to the image.
+uint16_t
+update_param_image(wmem_tree_t *param_image, wmem_allocator_t *scope, const baos_info_t *baos_info, uint32_t frame_num, uint32_t *prev_writes)
+{
+	const bool is_write = baos_info->subservice == SET_PARAMETER_BYTE_REQ_CODE;
+	uint16_t nr_of_new_param_bytes = 0;
+
+	for (uint16_t i = 0; i < baos_info->nr_of_param_bytes; i++)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_param_bytes,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		const uint32_t param_byte_id = (uint32_t)baos_info->start_param_byte + i;
+		if (param_byte_id > UINT16_MAX)
+			break;
+
+		baos_param_byte_t *param_byte = (baos_param_byte_t *)wmem_tree_lookup32(param_image, param_byte_id);
+		if (!param_byte)
+		{
+			param_byte = wmem_new0(scope, baos_param_byte_t);
+			param_byte->id = (uint16_t)param_byte_id;
+			wmem_tree_insert32(param_image, param_byte_id, param_byte);
+			nr_of_new_param_bytes++;
+		}
+
+		if (prev_writes)
+			prev_writes[i] = param_byte->last_write_frame;
+
+		param_byte->value = baos_info->param_bytes[i];
+		param_byte->last_frame = frame_num;
+		if (is_write)
+			param_byte->last_write_frame = frame_num;
 	}
-	// Add object server response if it's an error telegram
-	if (!nr_of_param_bytes && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	return nr_of_new_param_bytes;
+}
+
+// Dissects the parameter bytes of GetParameterByteRes and SetParameterByteReq
+// telegrams, and keeps the parameter byte image of the device up to date
+void
+dissect_param_bytes(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Index and number of parameter bytes must be in TVB's boundaries
+	if (tvb->length < (uint16_t)(BAOS_START_INDEX + 6))
+		return;
+
+	const uint16_t param_byte_offset = BAOS_START_INDEX + 6;
+	const uint16_t nr_of_param_bytes = tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN);
+
+	// Only the parameter bytes in TVB's boundaries are taken into account.
+	// If it's a flush command telegram where start byte index
+	// and nr of bytes are both 0x0000, there is nothing to do.
+	baos_info->start_param_byte = tvb_get_uint16(tvb, BAOS_START_INDEX + 2, ENC_BIG_ENDIAN);
+	baos_info->nr_of_param_bytes = (tvb->length > param_byte_offset) ?
+									MIN(nr_of_param_bytes, tvb->length - param_byte_offset) : 0;
+	if (!baos_info->nr_of_param_bytes)
+		return;
+	baos_info->param_bytes = (const uint8_t *)tvb_memdup(pinfo->pool, tvb, param_byte_offset, baos_info->nr_of_param_bytes);
+
+	// Update the device's parameter byte image on the first pass
+	if (!PINFO_FD_VISITED(pinfo))
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
+		if (!baos_info->frame_data->is_over_budget)
+		{
+			baos_info->frame_data->param_prev_writes = wmem_alloc0_array(wmem_file_scope(), uint32_t, baos_info->nr_of_param_bytes);
+			baos_info->conv_data->mem_usage[BAOS_MEM_FRAMES] += baos_info->nr_of_param_bytes * sizeof(uint32_t);
+		}
+		const uint16_t nr_of_new_param_bytes = update_param_image(
+																baos_info->conv_data->param_image,
+																wmem_file_scope(),
+																baos_info,
+																pinfo->num,
+																baos_info->frame_data->param_prev_writes
+																);
+		baos_info->conv_data->mem_usage[BAOS_MEM_PARAM_IMAGE] += nr_of_new_param_bytes * (sizeof(baos_param_byte_t) + BAOS_MEM_ENTRY_SIZE);
 	}
+
 	// Loop through all parameter bytes
-	for (uint16_t i = 0; i < nr_of_param_bytes; i++)
+	const uint32_t *prev_writes = baos_info->frame_data->param_prev_writes;
+	for (uint16_t i = 0; i < baos_info->nr_of_param_bytes; i++)
 	{
-
 		// Add parameter byte
-		if (tvb->length >= (uint16_t)(param_byte_offset + 1))
+		proto_item *param_byte_ti = proto_tree_add_item(
+														baos_payload_tree,
+														hf_baos_param_byte,
+														tvb,
+														param_byte_offset + i,
+														1,
+														ENC_BIG_ENDIAN
+														);
+		proto_item_append_text(param_byte_ti, " (byte %u)", baos_info->start_param_byte + i);
+
+		// Link to the frame the byte was previously written in
+		if (prev_writes && prev_writes[i])
 		{
-			proto_tree_add_item(
-								baos_payload_tree,
-								hf_baos_param_byte,
-								tvb,
-								param_byte_offset,
-								1,
-								ENC_BIG_ENDIAN
-								);
+			proto_item *prev_write_ti = proto_tree_add_uint(
+															baos_payload_tree,
+															hf_baos_param_byte_prev_write,
+															tvb,
+															param_byte_offset + i,
+															1,
+															prev_writes[i]
+															);
+			proto_item_set_generated(prev_write_ti);
 		}
-		param_byte_offset++;
-		if(tvb->length < (uint16_t)(param_byte_offset + 1))
-			break;
 	}
 }
 
-// Dissects SetParameterByteRes telegrams
+// Follows the transmission state of a datapoint across frames.
+// A transmission starts when the datapoint is first seen requested or
+// in progress, and ends when it is seen idle again. Must be called
+// after update_dp_history() on the first pass.
 void
-dissect_set_parameter_byte_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+track_dp_transmission(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t dp_state)
 {
-	// Add index of the starting parameter byte
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	baos_dp_history_t *dp_history = (baos_dp_history_t *)wmem_map_lookup(baos_info->conv_data->dp_history, GUINT_TO_POINTER(dp_id));
+	const uint8_t trans_state = dp_state & 0b0000'0011;
+	baos_dp_transmission_t *transmission;
+
+	if (!dp_history)
+		return;
+
+	if (trans_state == TRANS_REQUEST || trans_state == TRANS_IN_PROGRESS)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_start_param_byte,
-							tvb,
-							BAOS_START_INDEX + 2,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		if (!dp_history->trans_start_frame)
+		{
+			dp_history->trans_start_frame = pinfo->num;
+			dp_history->trans_start_ts = pinfo->abs_ts;
+			if (baos_info->frame_data->is_over_budget)
+				return;
+
+			// The start frame keeps a record of its own, flagged if the
+			// transmission gets stuck without the datapoint being reported
+			// again, or if it hasn't ended by the end of the capture
+			transmission = wmem_new0(wmem_file_scope(), baos_dp_transmission_t);
+			transmission->start_frame = pinfo->num;
+			transmission->trans_state = trans_state;
+			dp_history->trans_start = transmission;
+			wmem_list_append(baos_info->conv_data->pending_transmissions, dp_history);
+			dp_history->trans_frame = wmem_list_tail(baos_info->conv_data->pending_transmissions);
+
+			if (!baos_info->frame_data->dp_transmissions)
+				baos_info->frame_data->dp_transmissions = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+			wmem_map_insert(baos_info->frame_data->dp_transmissions, GUINT_TO_POINTER(dp_id), transmission);
+			baos_info->conv_data->mem_usage[BAOS_MEM_TRANSACTIONS] += sizeof(baos_dp_transmission_t) + 2 * BAOS_MEM_ENTRY_SIZE;
+			return;
+		}
 	}
-	// Add number of parameter bytes
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	else if (!dp_history->trans_start_frame)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_nr_of_param_bytes,
-							tvb,
-							BAOS_START_INDEX + 4,
-							2,
-							ENC_BIG_ENDIAN
-							);
+		return;
 	}
-	// Object server response (Notification about success or error)
-	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+
+	// The end of a transmission is still noted, the transmission isn't
+	if (baos_info->frame_data->is_over_budget)
 	{
-		proto_tree_add_item(
-							baos_payload_tree,
-							hf_baos_object_server_response,
-							tvb,
-							BAOS_START_INDEX + 6,
-							1,
-							ENC_BIG_ENDIAN
-							);
+		if (trans_state == IDLE_OK || trans_state == IDLE_ERROR)
+			end_dp_transmission(baos_info->conv_data, dp_history);
+		return;
 	}
-}
 
-// Main function of the dissector
-static bool
-dissect_baos_heur(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_)
+	transmission = wmem_new0(wmem_file_scope(), baos_dp_transmission_t);
+	transmission->start_frame = dp_history->trans_start_frame;
+	transmission->trans_state = trans_state;
+	nstime_delta(&transmission->duration, &pinfo->abs_ts, &dp_history->trans_start_ts);
+
+	if (trans_state == IDLE_OK || trans_state == IDLE_ERROR)
+	{
+		transmission->is_complete = true;
+		end_dp_transmission(baos_info->conv_data, dp_history);
+	}
+	else
+	{
+		transmission->is_stuck = nstime_to_msec(&transmission->duration) >= pref_trans_stuck_threshold;
+	}
+
+	if (!baos_info->frame_data->dp_transmissions)
+		baos_info->frame_data->dp_transmissions = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+	wmem_map_insert(baos_info->frame_data->dp_transmissions, GUINT_TO_POINTER(dp_id), transmission);
+	baos_info->conv_data->mem_usage[BAOS_MEM_TRANSACTIONS] += sizeof(baos_dp_transmission_t) + BAOS_MEM_ENTRY_SIZE;
+}
+
+// Notes the end of the pending transmission of a datapoint
+void
+end_dp_transmission(baos_conv_data_t *conv_data, baos_dp_history_t *dp_history)
 {
-	// It should not be possible for a
-	// serial BAOS telegram to be less than 10 bytes long.
-	if (tvb->length < 10)
-		return false;
+	if (dp_history->trans_start)
+		dp_history->trans_start->is_ended = true;
+	if (dp_history->trans_frame)
+		wmem_list_remove_frame(conv_data->pending_transmissions, dp_history->trans_frame);
+	dp_history->trans_start = NULL;
+	dp_history->trans_frame = NULL;
+	dp_history->trans_start_frame = 0;
+}
 
-	// Store index of the FT 1.2 start byte in var if FT 1.2 + BAOS pattern found,
-	// or store UINT8_MAX in var if pattern has not been found.
-	const uint8_t start_byte_index = check_serial_baos_pattern(tvb);
+// Flags the transmissions of a device that have been pending for longer
+// than the stuck threshold by the time of a telegram, whether it reports
+// their datapoints or not. Called on the first pass.
+void
+check_stuck_transmissions(packet_info *pinfo, baos_conv_data_t *conv_data)
+{
+	wmem_list_frame_t *trans_frame;
 
-	// Returns false and ends dissection routine
-	// if FT 1.2 + BAOS pattern has not been found
-	if (start_byte_index == UINT8_MAX)
-		return false;
+	// The oldest transmission is listed first
+	while ((trans_frame = wmem_list_head(conv_data->pending_transmissions)))
+	{
+		baos_dp_history_t *dp_history = (baos_dp_history_t *)wmem_list_frame_data(trans_frame);
+		nstime_t duration;
 
-	//
-	// From here onwards we can assume that
-	// a serial BAOS telegram has been found
-	//
+		nstime_delta(&duration, &pinfo->abs_ts, &dp_history->trans_start_ts);
+		if (nstime_to_msec(&duration) < pref_trans_stuck_threshold)
+			break;
 
-	// Stores length of the BAOS payload in var.
-	// Checksum byte needs to be subtracted.
-	const uint8_t baos_payload_len = tvb_get_uint8(tvb, start_byte_index + 1) - 1;
+		dp_history->trans_start->is_stuck = true;
+		dp_history->trans_start->duration = duration;
+		wmem_list_remove_frame(conv_data->pending_transmissions, trans_frame);
+		dp_history->trans_frame = NULL;
+	}
+}
 
-	// Label handled telegrams as "BAOS Telegram"
-	col_set_str(pinfo->cinfo, COL_INFO, "BAOS Telegram");
+// Adds the transmission of a datapoint that is still
+// pending or has ended in this frame to its subtree
+void
+dissect_dp_transmission(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_state_offset)
+{
+	if (!baos_info->frame_data->dp_transmissions)
+		return;
 
-	// Base BAOS tree
-	proto_item *baos_ti = proto_tree_add_item(
-												tree,
-												proto_baos,
+	const baos_dp_transmission_t *transmission = (const baos_dp_transmission_t *)wmem_map_lookup(
+																baos_info->frame_data->dp_transmissions,
+																GUINT_TO_POINTER(dp_id)
+																);
+	if (!transmission)
+		return;
+
+	// The start frame only tells about transmissions that got stuck,
+	// or that are still pending at the end of the capture, which is
+	// only known once the first pass is done
+	if (transmission->start_frame == pinfo->num && !transmission->is_stuck)
+	{
+		if (PINFO_FD_VISITED(pinfo) && !transmission->is_ended)
+			proto_tree_add_expert_format(
+										dp_tree,
+										pinfo,
+										&ei_baos_dp_trans_stuck,
+										tvb,
+										dp_state_offset,
+										1,
+										"Transmission of DP %u still pending at the end of the capture",
+										dp_id
+										);
+		return;
+	}
+
+	proto_item *start_in_ti = proto_tree_add_uint(
+													dp_tree,
+													hf_baos_dp_trans_start_in,
+													tvb,
+													dp_state_offset,
+													1,
+													transmission->start_frame
+													);
+	proto_item_set_generated(start_in_ti);
+	proto_item *trans_time_ti = proto_tree_add_time(
+													dp_tree,
+													hf_baos_dp_trans_time,
+													tvb,
+													dp_state_offset,
+													1,
+													&transmission->duration
+													);
+	proto_item_set_generated(trans_time_ti);
+
+	if (transmission->is_stuck)
+		expert_add_info_format(
+								pinfo,
+								trans_time_ti,
+								&ei_baos_dp_trans_stuck,
+								"Transmission of DP %u pending for more than %u ms",
+								dp_id,
+								pref_trans_stuck_threshold
+								);
+	else if (transmission->is_complete && transmission->trans_state == IDLE_ERROR)
+		expert_add_info(pinfo, trans_time_ti, &ei_baos_dp_trans_failed);
+}
+
+// Starts following a write of a SetDatapointValue.Req if its
+// command puts the datapoint on the bus. Called on the first pass.
+void
+track_dp_write_request(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t command)
+{
+	if (command != SEND_VALUE_ON_BUS && command != SET_NEW_VALUE_SEND_ON_BUS && command != READ_NEW_VALUE_VIA_BUS)
+		return;
+
+	// Writes are no longer followed once the budget is used up
+	if (baos_info->frame_data->is_over_budget)
+		return;
+
+	baos_dp_write_t *dp_write = wmem_new0(wmem_file_scope(), baos_dp_write_t);
+	dp_write->dp_id = dp_id;
+	dp_write->command = command;
+	dp_write->req_frame = pinfo->num;
+	dp_write->req_ts = pinfo->abs_ts;
+
+	if (!baos_info->frame_data->dp_writes)
+		baos_info->frame_data->dp_writes = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+	wmem_map_insert(baos_info->frame_data->dp_writes, GUINT_TO_POINTER(dp_id), dp_write);
+
+	// A newer write of the datapoint replaces an unconfirmed one
+	wmem_map_insert(baos_info->conv_data->pending_writes, GUINT_TO_POINTER(dp_id), dp_write);
+	baos_info->conv_data->mem_usage[BAOS_MEM_TRANSACTIONS] += sizeof(baos_dp_write_t) + BAOS_MEM_ENTRY_SIZE;
+}
+
+// Notes the object server response in a write of the matching request.
+// A write the object server refused doesn't go out on the bus, so it's
+// no longer waiting for its confirmation, and an indication that came
+// before the response didn't confirm it.
+void
+set_dp_write_response(void *key _U_, void *value, void *userdata)
+{
+	baos_dp_write_t *dp_write = (baos_dp_write_t *)value;
+	const baos_dp_write_response_t *response = (const baos_dp_write_response_t *)userdata;
+
+	dp_write->res_frame = response->pinfo->num;
+	dp_write->res_ts = response->pinfo->abs_ts;
+
+	if (!response->is_error)
+		return;
+
+	if (wmem_map_lookup(response->conv_data->pending_writes, GUINT_TO_POINTER(dp_write->dp_id)) == dp_write)
+		wmem_map_remove(response->conv_data->pending_writes, GUINT_TO_POINTER(dp_write->dp_id));
+
+	if (dp_write->ind_frame)
+	{
+		if (dp_write->ind_dp_writes)
+			wmem_map_remove(dp_write->ind_dp_writes, GUINT_TO_POINTER(dp_write->dp_id));
+		dp_write->ind_frame = 0;
+		dp_write->ind_dp_writes = NULL;
+	}
+}
+
+// Notes the object server response in the writes of the matching
+// SetDatapointValue.Req. Called on the first pass.
+void
+track_dp_write_response(packet_info *pinfo, baos_info_t *baos_info, bool is_error)
+{
+	const baos_frame_data_t *request_frame_data = baos_info->frame_data->matched;
+
+	if (PINFO_FD_VISITED(pinfo) || !request_frame_data || !request_frame_data->dp_writes)
+		return;
+
+	baos_dp_write_response_t response = { pinfo, baos_info->conv_data, is_error };
+	wmem_map_foreach(request_frame_data->dp_writes, set_dp_write_response, &response);
+	baos_info->frame_data->dp_writes = request_frame_data->dp_writes;
+}
+
+// Completes the pending write of a datapoint with the DatapointValue.Ind
+// that reports the datapoint after it. Called on the first pass.
+void
+track_dp_write_confirmation(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id)
+{
+	baos_dp_write_t *dp_write = (baos_dp_write_t *)wmem_map_remove(baos_info->conv_data->pending_writes, GUINT_TO_POINTER(dp_id));
+
+	if (!dp_write)
+		return;
+
+	dp_write->ind_frame = pinfo->num;
+	dp_write->ind_ts = pinfo->abs_ts;
+
+	// The request still links to the confirmation
+	if (baos_info->frame_data->is_over_budget)
+		return;
+
+	if (!baos_info->frame_data->dp_writes)
+		baos_info->frame_data->dp_writes = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
+	wmem_map_insert(baos_info->frame_data->dp_writes, GUINT_TO_POINTER(dp_id), dp_write);
+	dp_write->ind_dp_writes = baos_info->frame_data->dp_writes;
+	baos_info->conv_data->mem_usage[BAOS_MEM_TRANSACTIONS] += BAOS_MEM_ENTRY_SIZE;
+}
+
+// Adds links to the telegrams of a datapoint write
+// and the latency of each leg to the datapoint's subtree
+void
+dissect_dp_write(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_id_offset)
+{
+	if (!baos_info->frame_data->dp_writes)
+		return;
+
+	const baos_dp_write_t *dp_write = (const baos_dp_write_t *)wmem_map_lookup(baos_info->frame_data->dp_writes, GUINT_TO_POINTER(dp_id));
+	if (!dp_write)
+		return;
+
+	nstime_t leg_time;
+	proto_item *ti;
+
+	// Link to the other telegrams of the write
+	if (dp_write->req_frame != pinfo->num)
+	{
+		ti = proto_tree_add_uint(dp_tree, hf_baos_dp_write_req_in, tvb, dp_id_offset, 2, dp_write->req_frame);
+		proto_item_set_generated(ti);
+	}
+	if (dp_write->res_frame)
+	{
+		ti = proto_tree_add_uint(dp_tree, hf_baos_dp_write_res_in, tvb, dp_id_offset, 2, dp_write->res_frame);
+		proto_item_set_generated(ti);
+	}
+	if (dp_write->ind_frame && dp_write->ind_frame != pinfo->num)
+	{
+		ti = proto_tree_add_uint(dp_tree, hf_baos_dp_write_ind_in, tvb, dp_id_offset, 2, dp_write->ind_frame);
+		proto_item_set_generated(ti);
+	}
+
+	// Latency of the host and serial link to the object server
+	if (dp_write->res_frame)
+	{
+		nstime_delta(&leg_time, &dp_write->res_ts, &dp_write->req_ts);
+		ti = proto_tree_add_time(dp_tree, hf_baos_dp_write_res_time, tvb, dp_id_offset, 2, &leg_time);
+		proto_item_set_generated(ti);
+	}
+	// Latency of the KNX bus until the value is confirmed,
+	// unless the indication came before the response
+	if (dp_write->res_frame && dp_write->ind_frame && nstime_cmp(&dp_write->ind_ts, &dp_write->res_ts) >= 0)
+	{
+		nstime_delta(&leg_time, &dp_write->ind_ts, &dp_write->res_ts);
+		ti = proto_tree_add_time(dp_tree, hf_baos_dp_write_ind_time, tvb, dp_id_offset, 2, &leg_time);
+		proto_item_set_generated(ti);
+	}
+	// End-to-end latency
+	if (dp_write->ind_frame)
+	{
+		nstime_delta(&leg_time, &dp_write->ind_ts, &dp_write->req_ts);
+		ti = proto_tree_add_time(dp_tree, hf_baos_dp_write_latency, tvb, dp_id_offset, 2, &leg_time);
+		proto_item_set_generated(ti);
+	}
+}
+
+// Adds a datapoint updated from the bus to the sliding
+// window of the device. Called on the first pass.
+void
+add_bus_load_event(baos_conv_data_t *conv_data, packet_info *pinfo, uint16_t dp_id)
+{
+	baos_bus_load_window_t *window = &conv_data->bus_load_window;
+
+	// Grow the ring buffer, keeping the events in order
+	if (window->count == window->capacity)
+	{
+		const uint32_t capacity = window->capacity ? window->capacity * 2 : 64;
+		baos_bus_load_event_t *events = wmem_alloc_array(wmem_file_scope(), baos_bus_load_event_t, capacity);
+		for (uint32_t i = 0; i < window->count; i++)
+			events[i] = window->events[(window->head + i) % window->capacity];
+		wmem_free(wmem_file_scope(), window->events);
+		conv_data->mem_usage[BAOS_MEM_BUS_LOAD] += (capacity - window->capacity) * sizeof(baos_bus_load_event_t);
+		window->events = events;
+		window->capacity = capacity;
+		window->head = 0;
+	}
+
+	baos_bus_load_event_t *event = &window->events[(window->head + window->count) % window->capacity];
+	event->ts = pinfo->abs_ts;
+	event->dp_id = dp_id;
+	window->count++;
+
+	const unsigned dp_count = GPOINTER_TO_UINT(wmem_map_lookup(window->dp_counts, GUINT_TO_POINTER(dp_id)));
+	wmem_map_insert(window->dp_counts, GUINT_TO_POINTER(dp_id), GUINT_TO_POINTER(dp_count + 1));
+	if (!dp_count)
+		conv_data->mem_usage[BAOS_MEM_BUS_LOAD] += BAOS_MEM_ENTRY_SIZE;
+}
+
+// Drops the events that have left the sliding window and estimates
+// the bus load at the time of the DatapointValue.Ind. Called on the first pass.
+void
+update_bus_load(packet_info *pinfo, baos_info_t *baos_info)
+{
+	baos_bus_load_window_t *window = &baos_info->conv_data->bus_load_window;
+	const unsigned window_ms = MAX(pref_bus_load_window, 1);
+
+	while (window->count)
+	{
+		const baos_bus_load_event_t *event = &window->events[window->head];
+		nstime_t event_age;
+		nstime_delta(&event_age, &pinfo->abs_ts, &event->ts);
+		if (nstime_to_msec(&event_age) < window_ms)
+			break;
+
+		const unsigned dp_count = GPOINTER_TO_UINT(wmem_map_lookup(window->dp_counts, GUINT_TO_POINTER(event->dp_id)));
+		if (dp_count > 1)
+			wmem_map_insert(window->dp_counts, GUINT_TO_POINTER(event->dp_id), GUINT_TO_POINTER(dp_count - 1));
+		else
+		{
+			wmem_map_remove(window->dp_counts, GUINT_TO_POINTER(event->dp_id));
+			baos_info->conv_data->mem_usage[BAOS_MEM_BUS_LOAD] -= BAOS_MEM_ENTRY_SIZE;
+		}
+
+		window->head = (window->head + 1) % window->capacity;
+		window->count--;
+	}
+
+	const double rate = window->count * 1000.0 / window_ms;
+	if (rate > window->peak_rate)
+	{
+		window->peak_rate = rate;
+		window->peak_frame = pinfo->num;
+	}
+
+	// The window is kept up to date, the estimate of the telegram isn't
+	if (baos_info->frame_data->is_over_budget)
+		return;
+
+	baos_bus_load_t *bus_load = wmem_new0(wmem_file_scope(), baos_bus_load_t);
+	bus_load->rate = rate;
+	bus_load->distinct_dps = wmem_map_size(window->dp_counts);
+	bus_load->is_storm = pref_bus_storm_threshold && bus_load->rate >= pref_bus_storm_threshold;
+	bus_load->peak_rate = window->peak_rate;
+	bus_load->peak_frame = window->peak_frame;
+
+	baos_info->frame_data->bus_load = bus_load;
+	baos_info->conv_data->mem_usage[BAOS_MEM_FRAMES] += sizeof(baos_bus_load_t);
+}
+
+// Adds the estimated bus load to DatapointValue.Ind telegrams
+void
+dissect_bus_load(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, baos_info_t *baos_info)
+{
+	const baos_bus_load_t *bus_load = baos_info->frame_data->bus_load;
+
+	if (!bus_load)
+		return;
+
+	proto_item *rate_ti = proto_tree_add_double(
+												baos_payload_tree,
+												hf_baos_bus_load_rate,
 												tvb,
-												start_byte_index,
-												-1,
-												ENC_NA
+												0,
+												0,
+												bus_load->rate
 												);
-	proto_tree *baos_tree = proto_item_add_subtree(baos_ti, ett_baos);
-
-	// FT 1.2 frame subtree
-	proto_item *ft12_ti = proto_tree_add_item(
-												baos_tree,
-												hf_baos_ft12,
+	proto_item_set_generated(rate_ti);
+	proto_item *distinct_dps_ti = proto_tree_add_uint(
+												baos_payload_tree,
+												hf_baos_bus_load_distinct_dps,
 												tvb,
-												start_byte_index,
-												5,
-												ENC_NA
+												0,
+												0,
+												bus_load->distinct_dps
 												);
-	proto_tree *ft12_tree = proto_item_add_subtree(ft12_ti, ett_ft12);
+	proto_item_set_generated(distinct_dps_ti);
+	proto_item *peak_rate_ti = proto_tree_add_double(
+												baos_payload_tree,
+												hf_baos_bus_load_peak_rate,
+												tvb,
+												0,
+												0,
+												bus_load->peak_rate
+												);
+	proto_item_set_generated(peak_rate_ti);
+	if (bus_load->peak_frame)
+	{
+		proto_item *peak_in_ti = proto_tree_add_uint(
+												baos_payload_tree,
+												hf_baos_bus_load_peak_in,
+												tvb,
+												0,
+												0,
+												bus_load->peak_frame
+												);
+		proto_item_set_generated(peak_in_ti);
+	}
 
-	// FT 1.2 header subtree
-	proto_item *ft12_header_ti = proto_tree_add_item(
-													ft12_tree,
-													hf_baos_ft12_header,
+	if (bus_load->is_storm)
+		expert_add_info_format(
+								pinfo,
+								rate_ti,
+								&ei_baos_bus_storm,
+								"Bus storm: %.1f datapoint updates per second from the bus",
+								bus_load->rate
+								);
+}
+
+// Compares a GetDatapointValue.Req with the previous one of the device,
+// looking for overlapping datapoint ranges and for polls that are
+// repeated although the previous identical poll returned no changes.
+void
+analyze_poll_request(packet_info *pinfo, baos_info_t *baos_info, uint16_t start_dp_id, uint16_t nr_of_dps, uint8_t filter)
+{
+	if (PINFO_FD_VISITED(pinfo) || baos_info->frame_data->is_over_budget)
+		return;
+
+	baos_conv_data_t *conv_data = baos_info->conv_data;
+	baos_poll_result_t *poll = wmem_new0(wmem_file_scope(), baos_poll_result_t);
+	conv_data->mem_usage[BAOS_MEM_FRAMES] += sizeof(baos_poll_result_t);
+
+	poll->start_dp_id = start_dp_id;
+	poll->nr_of_dps = nr_of_dps;
+	poll->filter = filter;
+
+	if (conv_data->last_poll)
+	{
+		const baos_poll_result_t *last_poll = conv_data->last_poll->poll;
+
+		if (last_poll->start_dp_id == start_dp_id && last_poll->nr_of_dps == nr_of_dps && last_poll->filter == filter)
+		{
+			if (last_poll->is_answered && !last_poll->changed_dps)
+				poll->flags |= BAOS_POLL_REPEATED;
+		}
+		else if ((uint32_t)start_dp_id < (uint32_t)last_poll->start_dp_id + last_poll->nr_of_dps &&
+				(uint32_t)last_poll->start_dp_id < (uint32_t)start_dp_id + nr_of_dps)
+		{
+			poll->flags |= BAOS_POLL_OVERLAP;
+		}
+	}
+
+	baos_info->frame_data->poll = poll;
+	conv_data->last_poll = baos_info->frame_data;
+}
+
+// Adds the results of the polling analysis as generated
+// fields and ExpertInfo to GetDatapointValue telegrams.
+void
+dissect_poll_result(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, baos_info_t *baos_info)
+{
+	const baos_poll_result_t *poll = baos_info->frame_data->poll;
+
+	if (!poll)
+		return;
+
+	if (baos_info->subservice == GET_DATAPOINT_VALUE_REQ_CODE)
+	{
+		if (poll->flags & BAOS_POLL_OVERLAP)
+			proto_tree_add_expert(baos_payload_tree, pinfo, &ei_baos_poll_overlap, tvb, 0, 0);
+		if (poll->flags & BAOS_POLL_REPEATED)
+			proto_tree_add_expert(baos_payload_tree, pinfo, &ei_baos_poll_repeated, tvb, 0, 0);
+		return;
+	}
+
+	proto_item *changed_dps_ti = proto_tree_add_uint(
+													baos_payload_tree,
+													hf_baos_poll_changed_dps,
 													tvb,
-													start_byte_index,
-													5,
-													ENC_NA
+													0,
+													0,
+													poll->changed_dps
 													);
-	proto_tree *ft12_header_tree = proto_item_add_subtree(ft12_header_ti, ett_ft12_header);
+	proto_item_set_generated(changed_dps_ti);
+	proto_item *unchanged_dps_ti = proto_tree_add_uint(
+													baos_payload_tree,
+													hf_baos_poll_unchanged_dps,
+													tvb,
+													0,
+													0,
+													poll->returned_dps - poll->changed_dps
+													);
+	proto_item_set_generated(unchanged_dps_ti);
+	proto_item *wasted_bytes_ti = proto_tree_add_uint(
+													baos_payload_tree,
+													hf_baos_poll_wasted_bytes,
+													tvb,
+													0,
+													0,
+													poll->wasted_bytes
+													);
+	proto_item_set_generated(wasted_bytes_ti);
 
-	// Add FT 1.2 header items
-	proto_tree_add_item(
-						ft12_header_tree,
-						hf_baos_ft12_startbyte,
-						tvb,
-						start_byte_index,
-						1,
-						ENC_BIG_ENDIAN
-						);
-	proto_tree_add_item(
-						ft12_header_tree,
-	 					hf_baos_ft12_lengthbyte,
-					 	tvb,
-					 	start_byte_index + 1,
-					  	1,
-						ENC_BIG_ENDIAN
-						);
-	proto_tree_add_item(
-						ft12_header_tree,
-	 					hf_baos_ft12_lengthbyte,
-					 	tvb,
-					 	start_byte_index + 2,
-					  	1,
-						ENC_BIG_ENDIAN
-						);
-	proto_tree_add_item(
-						ft12_header_tree,
-	 					hf_baos_ft12_startbyte,
-					 	tvb,
-					 	start_byte_index + 3,
-					  	1,
-						ENC_BIG_ENDIAN
-						);
-	proto_tree_add_item(
-						ft12_header_tree,
-	 					hf_baos_ft12_controllbyte,
-					 	tvb,
-					 	start_byte_index + 4,
-					  	1,
-						ENC_BIG_ENDIAN
-						);
+	if (!poll->changed_dps)
+		expert_add_info(pinfo, changed_dps_ti, &ei_baos_poll_no_changes);
+}
+
+// Compares the length of the BAOS payload with the buffer size
+// reported by the device. Adds the buffer size and the buffer
+// utilization as generated fields, and ExpertInfo if the payload
+// comes close to or exceeds the buffer size.
+void
+dissect_buffer_utilization(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t baos_payload_len, baos_info_t *baos_info)
+{
+	baos_info->buffer_utilization = -1;
+
+	// Store the buffer size in effect on the first pass.
+	// The current buffer size takes precedence over the maximum buffer size.
+	if (!PINFO_FD_VISITED(pinfo))
+	{
+		const baos_device_profile_t *device_profile = &baos_info->conv_data->device_profile;
+
+		if (device_profile->known_server_items & (1u << CURRENT_BUFF_SIZE))
+			baos_info->frame_data->buffer_size = device_profile->current_buffer_size;
+		else if (device_profile->known_server_items & (1u << MAX_BUFFER_SIZE))
+			baos_info->frame_data->buffer_size = device_profile->max_buffer_size;
+	}
+
+	const uint16_t buffer_size = baos_info->frame_data->buffer_size;
+	if (!buffer_size)
+		return;
+
+	baos_info->buffer_utilization = (baos_payload_len * 100) / buffer_size;
+
+	proto_item *buffer_size_ti = proto_tree_add_uint(
+													baos_payload_tree,
+													hf_baos_buffer_size,
+													tvb,
+													0,
+													0,
+													buffer_size
+													);
+	proto_item_set_generated(buffer_size_ti);
+	proto_item *buffer_utilization_ti = proto_tree_add_uint(
+													baos_payload_tree,
+													hf_baos_buffer_utilization,
+													tvb,
+													0,
+													0,
+													baos_info->buffer_utilization
+													);
+	proto_item_set_generated(buffer_utilization_ti);
+
+	if (baos_payload_len > buffer_size)
+	{
+		expert_add_info_format(pinfo, buffer_utilization_ti, &ei_baos_buffer_exceeded,
+								"BAOS payload of %u bytes exceeds the buffer size of %u bytes",
+								baos_payload_len, buffer_size);
+	}
+	else if ((unsigned)baos_info->buffer_utilization >= pref_buffer_warning_threshold)
+	{
+		expert_add_info_format(pinfo, buffer_utilization_ti, &ei_baos_buffer_nearly_full,
+								"BAOS payload of %u bytes uses %d%% of the buffer size of %u bytes",
+								baos_payload_len, baos_info->buffer_utilization, buffer_size);
+	}
+}
+
+// Stores the data of a single server item in the device profile.
+// Only server items that identify the device or describe
+// its buffer are stored.
+void
+update_device_profile(baos_device_profile_t *device_profile, tvbuff_t *tvb, packet_info *pinfo, uint16_t server_item_id, uint16_t server_item_data_offset)
+{
+	switch (server_item_id)
+	{
+		case HARDWARE_TYPE:
+			tvb_memcpy(tvb, device_profile->hardware_type, server_item_data_offset, 6);
+			break;
+		case HARDWARE_VERSION:
+			device_profile->hardware_version = tvb_get_uint8(tvb, server_item_data_offset);
+			break;
+		case FIRMWARE_VERSION:
+			device_profile->firmware_version = tvb_get_uint8(tvb, server_item_data_offset);
+			break;
+		case KNX_MANUFACTURER_CODE_DEV:
+			device_profile->knx_man_code_dev = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		case KNX_MANUFACTURER_CODE_APP:
+			device_profile->knx_man_code_app = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		case APPLICATION_ID_ETS:
+			device_profile->app_id = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		case APPLICATION_VERSION_ETS:
+			device_profile->app_version = tvb_get_uint8(tvb, server_item_data_offset);
+			break;
+		case SERIAL_NUMBER:
+			tvb_memcpy(tvb, device_profile->serial_number, server_item_data_offset, 6);
+			break;
+		case INDIVIDUAL_ADDRESS:
+			device_profile->individual_address = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		case MAX_BUFFER_SIZE:
+			device_profile->max_buffer_size = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		case CURRENT_BUFF_SIZE:
+			device_profile->current_buffer_size = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+			break;
+		default:
+			return;
+	}
+
+	if (!device_profile->known_server_items)
+		device_profile->first_frame = pinfo->num;
+	device_profile->last_frame = pinfo->num;
+	device_profile->known_server_items |= 1u << server_item_id;
+}
+
+// Adds the data of a single server item as the typed field found
+// in the server item descriptor table. Falls back to the generic
+// server item data field for unknown server items, and for server
+// items whose length doesn't match the length of the typed field.
+void
+dissect_server_item_data(tvbuff_t *tvb, proto_tree *server_item_tree, uint16_t server_item_id, uint16_t server_item_data_offset, uint8_t server_item_data_length)
+{
+	const server_item_desc_t *server_item_desc = (server_item_id < array_length(server_item_descs)) ?
+													&server_item_descs[server_item_id] : NULL;
+
+	if (!server_item_desc || !server_item_desc->hf || server_item_desc->length != server_item_data_length)
+	{
+		proto_tree_add_item(
+							server_item_tree,
+							hf_baos_server_item_data,
+							tvb,
+							server_item_data_offset,
+							server_item_data_length,
+							ENC_NA
+							);
+	}
+	else
+	{
+		if (server_item_desc->bits)
+		{
+			proto_tree_add_bitmask(
+									server_item_tree,
+									tvb,
+									server_item_data_offset,
+									*server_item_desc->hf,
+									*server_item_desc->ett,
+									server_item_desc->bits,
+									ENC_BIG_ENDIAN
+									);
+		}
+		else
+		{
+			proto_tree_add_item(
+								server_item_tree,
+								*server_item_desc->hf,
+								tvb,
+								server_item_data_offset,
+								server_item_data_length,
+								ENC_BIG_ENDIAN
+								);
+		}
+
+		// Filters written for the field formerly
+		// used for the server item still match
+		if (server_item_desc->shared_hf)
+		{
+			proto_item *shared_ti = proto_tree_add_item(
+														server_item_tree,
+														*server_item_desc->shared_hf,
+														tvb,
+														server_item_data_offset,
+														server_item_data_length,
+														ENC_BIG_ENDIAN
+														);
+			proto_item_set_hidden(shared_ti);
+		}
+	}
+}
+
+// Dissects SetServerItemReq, GetServerItemRes and ServerItemInd telegrams
+void
+dissect_long_server_item_telegram(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, const uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Device profile is only assembled from the server items
+	// reported by the device, and only on the first pass
+	baos_device_profile_t *device_profile = (!PINFO_FD_VISITED(pinfo) && baos_info->subservice != SET_SERVER_ITEM_REQ_CODE) ?
+												&baos_info->conv_data->device_profile : NULL;
+
+	// Store nr of server items in var if it's in TVB's boundaries,
+	// or assign UINT8_MAX to var if TVB is not long enough
+	const uint16_t nr_of_server_items = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+
+	uint16_t server_item_id_offset = BAOS_START_INDEX + 6;
+	uint16_t nr_of_server_items_found = 0;
+
+	// Add ID of the starting server item
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_server_item_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of server items
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_server_items,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	if (nr_of_server_items == 0)
+	{
+		// Error route
+		if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+		{
+			proto_tree_add_item(
+								baos_payload_tree,
+								hf_baos_object_server_response,
+								tvb,
+								server_item_id_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+		}
+	}
+	else
+	{
+		// Loop through all server items
+		for (uint16_t i = 0; i < nr_of_server_items; i++)
+		{
+			// Server item ID must be in TVB's boundaries
+			// to be able to build the item's subtree
+			if (tvb->length < (uint16_t)(server_item_id_offset + 2))
+				break;
+
+			// Setup variables for current server item iteration
+			uint16_t server_item_length_offset	= server_item_id_offset + 2;
+			uint16_t server_item_data_offset	= server_item_length_offset + 1;
+			uint16_t server_item_id				= tvb_get_uint16(tvb, server_item_id_offset, ENC_BIG_ENDIAN);
+			uint8_t server_item_data_length		= tvb->length > server_item_length_offset ?
+												tvb_get_uint8(tvb, server_item_length_offset) : UINT8_MAX;
+
+			// Every server item gets its own collapsible subtree,
+			// so that long telegrams stay navigable
+			proto_item *server_item_ti = NULL;
+			proto_tree *server_item_tree = proto_tree_add_subtree_format(
+												baos_payload_tree,
+												tvb,
+												server_item_id_offset,
+												get_item_length_in_tvb(tvb, server_item_id_offset, server_item_data_length + 3),
+												ett_baos_server_item,
+												&server_item_ti,
+												"Server item %u: %s",
+												server_item_id,
+												val_to_str_ext_const(server_item_id, &vs_server_items_ext, "Unknown server item")
+												);
+
+			// Add server item ID
+			proto_tree_add_item(
+								server_item_tree,
+								hf_baos_server_item_id,
+								tvb,
+								server_item_id_offset,
+								2,
+								ENC_BIG_ENDIAN
+								);
+			// Add server item data length
+			if (tvb->length >= (uint16_t)(server_item_length_offset + 1))
+			{
+				proto_tree_add_item(
+									server_item_tree,
+									hf_baos_server_item_length,
+									tvb,
+									server_item_length_offset,
+									1,
+									ENC_BIG_ENDIAN
+									);
+			}
+			// Add server item data
+			if (tvb->length >= (uint16_t)(server_item_data_offset + server_item_data_length))
+			{
+				dissect_server_item_data(
+										tvb,
+										server_item_tree,
+										server_item_id,
+										server_item_data_offset,
+										server_item_data_length
+										);
+
+				if (device_profile && server_item_id < array_length(server_item_descs) &&
+					server_item_descs[server_item_id].length == server_item_data_length)
+				{
+					update_device_profile(device_profile, tvb, pinfo, server_item_id, server_item_data_offset);
+				}
+				// A new buffer size only takes effect once the response confirms it
+				if (baos_info->subservice == SET_SERVER_ITEM_REQ_CODE && !PINFO_FD_VISITED(pinfo) &&
+					server_item_id == CURRENT_BUFF_SIZE && server_item_data_length == 2)
+				{
+					baos_info->frame_data->requested_buffer_size = tvb_get_uint16(tvb, server_item_data_offset, ENC_BIG_ENDIAN);
+				}
+
+				// Show the raw value in the summary line of the server item
+				if (baos_payload_tree)
+				{
+					proto_item_append_text(
+											server_item_ti,
+											" = %s",
+											tvb_bytes_to_str_punct(pinfo->pool, tvb, server_item_data_offset, server_item_data_length, ' ')
+											);
+				}
+			}
+			// The next server item can't be in TVB's
+			// boundaries if the current one is cut off
+			if (tvb->length < (uint16_t)(server_item_data_offset + server_item_data_length))
+				break;
+			nr_of_server_items_found++;
+			server_item_id_offset += server_item_data_length + 3;
+		}
+		dissect_item_truncation(tvb, pinfo, baos_payload_tree, start_byte_index, nr_of_server_items_found, nr_of_server_items, "server items");
+	}
+}
+
+// Dissects GetServerItemReq telegrams
+void
+dissect_get_server_item_req(tvbuff_t *tvb, packet_info *pinfo _U_, proto_tree *baos_payload_tree, const uint8_t start_byte_index)
+{
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_server_item_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_server_items,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Dissects GetDatapointDescriptionReq telegrams
+void
+dissect_get_datapoint_desc_req(tvbuff_t *tvb, packet_info *pinfo _U_, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+{
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Dissects GetDescriptionStringReq telegrams
+void
+dissect_get_desc_string_req(tvbuff_t *tvb, packet_info *pinfo _U_, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+{
+	// Add index of the starting description string
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_desc_string,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of description strings
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_desc_strings,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Dissects GetDatapointValueReq telegrams
+void
+dissect_get_datapoint_value_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add datapoint filter code
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_dp_filter,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+
+		// Compare poll with the previous one of the device
+		analyze_poll_request(
+							pinfo,
+							baos_info,
+							tvb_get_uint16(tvb, BAOS_START_INDEX + 2, ENC_BIG_ENDIAN),
+							tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN),
+							tvb_get_uint8(tvb, BAOS_START_INDEX + 6)
+							);
+	}
+	dissect_poll_result(tvb, pinfo, baos_payload_tree, baos_info);
+}
+
+// Dissects SetDatapointValueReq telegrams
+void
+dissect_set_datapoint_value_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Store nr of datapoints in var if it's in TVB's boundaries,
+	// or assign UINT16_MAX to var if TVB is not long enough
+	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+
+	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	uint16_t nr_of_dps_found = 0;
+
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Loop through all datapoints
+	for (uint16_t i = 0; i < nr_of_dps; i++)
+	{
+		// Datapoint ID must be in TVB's boundaries
+		// to be able to build the datapoint's subtree
+		if (tvb->length < (uint16_t)(dp_id_offset + 2))
+			break;
+
+		// Setup variables for current server item iteration
+		uint16_t dp_command_offset	= dp_id_offset + 2;
+		uint16_t dp_length_offset	= dp_command_offset + 1;
+		uint16_t dp_value_offset	= dp_length_offset + 1;
+		uint16_t dp_id				= tvb_get_uint16(tvb, dp_id_offset, ENC_BIG_ENDIAN);
+		uint8_t dp_length			= (tvb->length > dp_length_offset) ?
+										tvb_get_uint8(tvb, dp_length_offset) : UINT8_MAX;
+
+		// Label the datapoint with its name if known
+		// and list it in the info column
+		const char *dp_label = get_dp_label(pinfo, baos_info->conv_data, dp_id);
+		add_dp_label_to_col_info(pinfo, i, dp_label);
+
+		// Every datapoint gets its own collapsible subtree,
+		// so that long telegrams stay navigable
+		proto_item *dp_ti = NULL;
+		proto_tree *dp_tree = proto_tree_add_subtree_format(
+											baos_payload_tree,
+											tvb,
+											dp_id_offset,
+											get_item_length_in_tvb(tvb, dp_id_offset, dp_length + 4),
+											ett_baos_dp,
+											&dp_ti,
+											"%s",
+											dp_label
+											);
+
+		// Add datapoint ID
+		proto_tree_add_item(
+							dp_tree,
+							hf_baos_dp_id,
+							tvb,
+							dp_id_offset,
+							2,
+							ENC_BIG_ENDIAN
+							);
+		// Add datapoint command
+		if (tvb->length >= (uint16_t)(dp_command_offset + 1))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_command,
+								tvb,
+								dp_command_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+
+			// Follow writes that go out on the bus
+			if (!PINFO_FD_VISITED(pinfo))
+				track_dp_write_request(pinfo, baos_info, dp_id, tvb_get_uint8(tvb, dp_command_offset));
+			dissect_dp_write(tvb, pinfo, dp_tree, baos_info, dp_id, dp_id_offset);
+		}
+		// Add datapoint length
+		if (tvb->length >= (uint16_t)(dp_length_offset + 1))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_length,
+								tvb,
+								dp_length_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+		}
+		// Add datapoint value
+		if (tvb->length >= (uint16_t)(dp_value_offset + dp_length))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_value,
+								tvb,
+								dp_value_offset,
+								dp_length,
+								ENC_BIG_ENDIAN
+								);
+			const char *dp_value_text = dissect_dp_value_typed(tvb, pinfo, dp_tree, baos_info, dp_id, dp_value_offset, dp_length);
+			// The raw value is only formatted for the tree and the taps
+			if (!dp_value_text && (baos_payload_tree || have_tap_listener(baos_tap)))
+				dp_value_text = tvb_bytes_to_str_punct(pinfo->pool, tvb, dp_value_offset, dp_length, ' ');
+			if (baos_payload_tree)
+			{
+				proto_item_append_text(
+										dp_ti,
+										" = %s (%s)",
+										dp_value_text,
+										val_to_str_const(tvb_get_uint8(tvb, dp_command_offset), vs_dp_commands, "Unknown command")
+										);
+			}
+			add_dp_value(pinfo, baos_info, dp_id, tvb_get_uint8(tvb, dp_command_offset), dp_value_text);
+		}
+		// The next datapoint can't be in TVB's
+		// boundaries if the current one is cut off
+		if (tvb->length < (uint16_t)(dp_value_offset + dp_length))
+			break;
+		nr_of_dps_found++;
+		dp_id_offset += dp_length + 4;
+	}
+	dissect_item_truncation(tvb, pinfo, baos_payload_tree, start_byte_index, nr_of_dps_found, nr_of_dps, "datapoints");
+}
+
+// Dissects GetParameterByteReq telegrams
+void
+dissect_get_parameter_byte_req(tvbuff_t *tvb, packet_info *pinfo _U_, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+{
+	// Add index of the starting parameter byte
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_param_byte,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of parameter bytes
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_param_bytes,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Dissects SetParameterByteReq telegrams
+void
+dissect_set_parameter_byte_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Add index of the starting parameter byte
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_param_byte,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of parameter bytes
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_param_bytes,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add parameter bytes
+	dissect_param_bytes(tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+}
+
+// Dissects SetServerItemRes telegrams
+void
+dissect_set_server_item_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Add ID of the starting server item
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_server_item_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of server items
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_server_items,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Object server response (Notification about success or error)
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+
+		// Apply the buffer size set by the request if the object server accepted it
+		const baos_frame_data_t *request_frame_data = baos_info->frame_data->matched;
+		if (!PINFO_FD_VISITED(pinfo) && request_frame_data && request_frame_data->requested_buffer_size &&
+			tvb_get_uint8(tvb, BAOS_START_INDEX + 6) == SUCCESS)
+		{
+			baos_device_profile_t *device_profile = &baos_info->conv_data->device_profile;
+
+			device_profile->current_buffer_size = request_frame_data->requested_buffer_size;
+			if (!device_profile->known_server_items)
+				device_profile->first_frame = pinfo->num;
+			device_profile->last_frame = pinfo->num;
+			device_profile->known_server_items |= 1u << CURRENT_BUFF_SIZE;
+		}
+	}
+}
+
+// Dissects GetDatapointDescriptionRes telegrams
+void
+dissect_get_datapoint_desc_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Store nr of datapoints in var if it's in TVB's boundaries,
+	// or assign UINT16_MAX to var if TVB is not long enough
+	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+
+	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	uint16_t nr_of_dps_found = 0;
+
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add object server response if it's an error telegram
+	if (!nr_of_dps && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Loop through all datapoints
+	for (uint16_t i = 0; i < nr_of_dps; i++)
+	{
+		// Datapoint ID must be in TVB's boundaries
+		// to be able to build the datapoint's subtree
+		if (tvb->length < (uint16_t)(dp_id_offset + 2))
+			break;
+
+		// Setup variables for current server item iteration
+		uint16_t dp_value_type_offset	= dp_id_offset + 2;
+		uint16_t dp_config_flags_offset	= dp_value_type_offset + 1;
+		uint16_t dp_dpt_offset			= dp_config_flags_offset + 1;
+		uint16_t dp_id					= tvb_get_uint16(tvb, dp_id_offset, ENC_BIG_ENDIAN);
+
+		// Label the datapoint with its name if known
+		// and list it in the info column
+		const char *dp_label = get_dp_label(pinfo, baos_info->conv_data, dp_id);
+		add_dp_label_to_col_info(pinfo, i, dp_label);
+
+		// Every datapoint gets its own collapsible subtree,
+		// so that long telegrams stay navigable
+		proto_item *dp_ti = NULL;
+		proto_tree *dp_tree = proto_tree_add_subtree_format(
+											baos_payload_tree,
+											tvb,
+											dp_id_offset,
+											get_item_length_in_tvb(tvb, dp_id_offset, 5),
+											ett_baos_dp,
+											&dp_ti,
+											"%s",
+											dp_label
+											);
+
+		// Add datapoint ID
+		proto_tree_add_item(
+							dp_tree,
+							hf_baos_dp_id,
+							tvb,
+							dp_id_offset,
+							2,
+							ENC_BIG_ENDIAN
+							);
+		// Add datapoint value type
+		if (tvb->length >= (uint16_t)(dp_value_type_offset + 1))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_value_type,
+								tvb,
+								dp_value_type_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+			proto_item_append_text(
+									dp_ti,
+									": %s",
+									val_to_str_const(tvb_get_uint8(tvb, dp_value_type_offset), vs_baos_dp_value_types, "Unknown value type")
+									);
+		}
+		// Add datapoint config flags
+		if (tvb->length >= (uint16_t)(dp_config_flags_offset + 1))
+		{
+			static int* const config_flags_bits[] = {
+				&hf_baos_dp_config_trans_prio,
+				&hf_baos_dp_config_dp_comm,
+				&hf_baos_dp_config_read_from_bus,
+				&hf_baos_dp_config_write_from_bus,
+				&hf_baos_dp_config_read_on_init,
+				&hf_baos_dp_config_trans_to_bus,
+				&hf_baos_dp_config_update_on_res,
+				NULL
+			};
+			proto_tree_add_bitmask(
+									dp_tree,
+									tvb,
+									dp_config_flags_offset,
+									hf_baos_dp_config_flags,
+									ett_baos_dp_config,
+									config_flags_bits,
+									ENC_BIG_ENDIAN
+									);
+		}
+		// Add datapoint type
+		if (tvb->length >= (uint16_t)(dp_dpt_offset + 1))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_dpt,
+								tvb,
+								dp_dpt_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+			proto_item_append_text(
+									dp_ti,
+									", %s",
+									val_to_str_ext_const(tvb_get_uint8(tvb, dp_dpt_offset), &vs_baos_dpts_ext, "Unknown DPT")
+									);
+			// Decode values of datapoints the catalog doesn't list with this DPT
+			store_dp_dpt(baos_info->conv_data, pinfo, dp_id, tvb_get_uint8(tvb, dp_dpt_offset));
+		}
+		if (tvb->length < (uint16_t)(dp_id_offset + 5))
+			break;
+		nr_of_dps_found++;
+		dp_id_offset += 5;
+	}
+	dissect_item_truncation(tvb, pinfo, baos_payload_tree, start_byte_index, nr_of_dps_found, nr_of_dps, "datapoint descriptions");
+}
+
+// Dissects GetDescriptionStringRes telegrams
+void
+dissect_get_desc_string_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Store nr of description strings in var if it's in TVB's boundaries,
+	// or assign UINT16_MAX to var if TVB is not long enough
+	const uint16_t nr_of_desc_strings = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+	// Store ID of the datapoint described by the first string in var
+	// if it's in TVB's boundaries, or assign 0 to var if TVB is not long enough
+	const uint16_t start_dp_id = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 2, ENC_BIG_ENDIAN) : 0;
+
+	uint16_t desc_string_len_offset = BAOS_START_INDEX + 6;
+	uint16_t nr_of_desc_strings_found = 0;
+
+	// Add ID of start desc string
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_desc_string,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of desc strings
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_desc_strings,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add object server response if it's an error telegram
+	if (!nr_of_desc_strings && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Loop through all desc strings
+	for (uint16_t i = 0; i < nr_of_desc_strings; i++)
+	{
+		// Description string length must be in TVB's boundaries
+		// to be able to build the description string's subtree
+		if (tvb->length < (uint16_t)(desc_string_len_offset + 2))
+			break;
+
+		uint16_t desc_string_offset = desc_string_len_offset + 2;
+
+		// Store description string length in var
+		const uint16_t desc_string_len = tvb_get_uint16(tvb, desc_string_len_offset, ENC_BIG_ENDIAN);
+
+		// The description string is the name of the datapoint
+		if (tvb->length >= (uint32_t)desc_string_offset + desc_string_len)
+			store_dp_name(baos_info->conv_data, tvb, pinfo, start_dp_id + i, desc_string_offset, desc_string_len);
+		if (i <= BAOS_COL_INFO_MAX_DPS)
+			add_dp_label_to_col_info(pinfo, i, get_dp_label(pinfo, baos_info->conv_data, start_dp_id + i));
+
+		// Every description string gets its own collapsible subtree,
+		// labeled with the ID of the datapoint it describes
+		proto_item *desc_string_ti = NULL;
+		proto_tree *desc_string_tree = proto_tree_add_subtree_format(
+											baos_payload_tree,
+											tvb,
+											desc_string_len_offset,
+											get_item_length_in_tvb(tvb, desc_string_len_offset, desc_string_len + 2),
+											ett_baos_desc_string,
+											&desc_string_ti,
+											"DP %u",
+											start_dp_id + i
+											);
+
+		// Add desc string len
+		proto_tree_add_item(
+							desc_string_tree,
+							hf_baos_desc_string_len,
+							tvb,
+							desc_string_len_offset,
+							2,
+							ENC_BIG_ENDIAN
+							);
+		// Add desc string
+		if (tvb->length >= (uint32_t)desc_string_offset + desc_string_len)
+		{
+			proto_tree_add_item(
+								desc_string_tree,
+								hf_baos_desc_string,
+								tvb,
+								desc_string_offset,
+								desc_string_len,
+								ENC_BIG_ENDIAN
+								);
+			proto_item_append_text(
+									desc_string_ti,
+									": \"%s\"",
+									tvb_format_text(pinfo->pool, tvb, desc_string_offset, desc_string_len)
+									);
+		}
+		// The next description string can't be in TVB's
+		// boundaries if the current one is cut off
+		if (tvb->length < (uint32_t)desc_string_offset + desc_string_len)
+			break;
+		nr_of_desc_strings_found++;
+		desc_string_len_offset += desc_string_len + 2;
+	}
+	dissect_item_truncation(tvb, pinfo, baos_payload_tree, start_byte_index, nr_of_desc_strings_found, nr_of_desc_strings, "description strings");
+}
+
+// Dissects GetDatapointValueRes telegrams
+void
+dissect_get_datapoint_value_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Share the polling analysis of the matching GetDatapointValue.Req
+	// with the response on the first pass. Indications are not polled.
+	baos_poll_result_t *poll = NULL;
+	if (!PINFO_FD_VISITED(pinfo) && baos_info->subservice == GET_DATAPOINT_VALUE_RES_CODE &&
+		baos_info->frame_data->matched && baos_info->frame_data->matched->poll)
+	{
+		poll = baos_info->frame_data->matched->poll;
+		poll->is_answered = true;
+		baos_info->frame_data->poll = poll;
+	}
+
+	// Store nr of datapoints in var if it's in TVB's boundaries,
+	// or assign UINT16_MAX to var if TVB is not long enough
+	const uint16_t nr_of_dps = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+
+	uint16_t dp_id_offset = BAOS_START_INDEX + 6;
+	uint16_t nr_of_dps_found = 0;
+
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add object server response if it's an error telegram
+	if (!nr_of_dps && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Loop through all datapoints
+	for (uint16_t i = 0; i < nr_of_dps; i++)
+	{
+		// Datapoint ID must be in TVB's boundaries
+		// to be able to build the datapoint's subtree
+		if (tvb->length < (uint16_t)(dp_id_offset + 2))
+			break;
+
+		// Setup variables for current server item iteration
+		uint16_t dp_state_offset	= dp_id_offset + 2;
+		uint16_t dp_length_offset	= dp_state_offset + 1;
+		uint16_t dp_value_offset	= dp_length_offset + 1;
+		uint16_t dp_id				= tvb_get_uint16(tvb, dp_id_offset, ENC_BIG_ENDIAN);
+		uint8_t dp_length			= (tvb->length > dp_length_offset) ?
+										tvb_get_uint8(tvb, dp_length_offset) : UINT8_MAX;
+
+		// Label the datapoint with its name if known
+		// and list it in the info column
+		const char *dp_label = get_dp_label(pinfo, baos_info->conv_data, dp_id);
+		add_dp_label_to_col_info(pinfo, i, dp_label);
+
+		// Every datapoint gets its own collapsible subtree,
+		// so that long telegrams stay navigable
+		proto_item *dp_ti = NULL;
+		proto_tree *dp_tree = proto_tree_add_subtree_format(
+											baos_payload_tree,
+											tvb,
+											dp_id_offset,
+											get_item_length_in_tvb(tvb, dp_id_offset, dp_length + 4),
+											ett_baos_dp,
+											&dp_ti,
+											"%s",
+											dp_label
+											);
+
+		// Add datapoint ID
+		proto_tree_add_item(
+							dp_tree,
+							hf_baos_dp_id,
+							tvb,
+							dp_id_offset,
+							2,
+							ENC_BIG_ENDIAN
+							);
+		// Add datapoint state
+		if (tvb->length >= (uint16_t)(dp_state_offset + 1))
+		{
+			static int* const dp_state_bits[] = {
+				&hf_baos_dp_state_valid,
+				&hf_baos_dp_state_update,
+				&hf_baos_dp_state_read_req,
+				&hf_baos_dp_state_trans,
+				NULL
+			};
+			proto_tree_add_bitmask(
+									dp_tree,
+									tvb,
+									dp_state_offset,
+									hf_baos_dp_state,
+									ett_baos_dp_state,
+									dp_state_bits,
+									ENC_BIG_ENDIAN
+									);
+		}
+		// Add datapoint length
+		if (tvb->length >= (uint16_t)(dp_length_offset + 1))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_length,
+								tvb,
+								dp_length_offset,
+								1,
+								ENC_BIG_ENDIAN
+								);
+		}
+		// Add datapoint value
+		if (tvb->length >= (uint16_t)(dp_value_offset + dp_length))
+		{
+			proto_tree_add_item(
+								dp_tree,
+								hf_baos_dp_value,
+								tvb,
+								dp_value_offset,
+								dp_length,
+								ENC_BIG_ENDIAN
+								);
+			const char *dp_value_text = dissect_dp_value_typed(tvb, pinfo, dp_tree, baos_info, dp_id, dp_value_offset, dp_length);
+			// The raw value is only formatted for the tree and the taps
+			if (!dp_value_text && (baos_payload_tree || have_tap_listener(baos_tap)))
+				dp_value_text = tvb_bytes_to_str_punct(pinfo->pool, tvb, dp_value_offset, dp_length, ' ');
+			if (baos_payload_tree)
+			{
+				proto_item_append_text(
+										dp_ti,
+										" = %s [%s]",
+										dp_value_text,
+										get_dp_state_summary(pinfo->pool, tvb_get_uint8(tvb, dp_state_offset))
+										);
+			}
+			add_dp_value(pinfo, baos_info, dp_id, tvb_get_uint8(tvb, dp_state_offset), dp_value_text);
+
+			// Keep track of the datapoint's value on the first pass
+			if (!PINFO_FD_VISITED(pinfo))
+			{
+				const bool is_changed = update_dp_history(
+														baos_info->conv_data,
+														tvb,
+														pinfo,
+														dp_id,
+														tvb_get_uint8(tvb, dp_state_offset),
+														dp_value_offset,
+														dp_length
+														);
+				if (poll)
+				{
+					poll->returned_dps++;
+					if (is_changed)
+						poll->changed_dps++;
+					else
+						poll->wasted_bytes += dp_length + 4;
+				}
+				track_dp_transmission(pinfo, baos_info, dp_id, tvb_get_uint8(tvb, dp_state_offset));
+				if (baos_info->subservice == DATAPOINT_VALUE_IND_CODE)
+				{
+					track_dp_write_confirmation(pinfo, baos_info, dp_id);
+
+					// Updates from the bus count towards the bus load
+					if (tvb_get_uint8(tvb, dp_state_offset) & 0b0000'1000)
+						add_bus_load_event(baos_info->conv_data, pinfo, dp_id);
+				}
+			}
+			dissect_dp_transmission(tvb, pinfo, dp_tree, baos_info, dp_id, dp_state_offset);
+			dissect_dp_write(tvb, pinfo, dp_tree, baos_info, dp_id, dp_id_offset);
+		}
+		// The next datapoint can't be in TVB's
+		// boundaries if the current one is cut off
+		if (tvb->length < (uint16_t)(dp_value_offset + dp_length))
+			break;
+		nr_of_dps_found++;
+		dp_id_offset += dp_length + 4;
+	}
+	dissect_item_truncation(tvb, pinfo, baos_payload_tree, start_byte_index, nr_of_dps_found, nr_of_dps, "datapoints");
+
+	// If nothing has changed, the whole transaction was in vain
+	if (poll && !poll->changed_dps)
+		poll->wasted_bytes = baos_info->frame_data->matched->telegram_length + baos_info->frame_data->telegram_length;
+
+	// Estimate the bus load on the first pass
+	if (!PINFO_FD_VISITED(pinfo) && baos_info->subservice == DATAPOINT_VALUE_IND_CODE)
+		update_bus_load(pinfo, baos_info);
+	dissect_bus_load(tvb, pinfo, baos_payload_tree, baos_info);
+
+	dissect_poll_result(tvb, pinfo, baos_payload_tree, baos_info);
+}
+
+// Dissects SetDatapointValueRes telegrams
+void
+dissect_set_datapoint_value_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Note the response in the writes of the request.
+	// Writes of a response cut off before the response code are kept.
+	const bool is_error = tvb->length >= (uint16_t)(BAOS_START_INDEX + 7) &&
+							tvb_get_uint8(tvb, BAOS_START_INDEX + 6) != SUCCESS;
+	track_dp_write_response(pinfo, baos_info, is_error);
+
+	// Add ID of the starting datapoint
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_dp_id,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of datapoints
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_dps,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Object server response (Notification about success or error)
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Dissects GetParameterByteRes telegrams
+void
+dissect_get_parameter_byte_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info)
+{
+	// Store nr of parameter bytes in var if it's in TVB's boundaries,
+	// or assign UINT16_MAX to var if TVB is not long enough
+	const uint16_t nr_of_param_bytes = (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6)) ?
+										tvb_get_uint16(tvb, BAOS_START_INDEX + 4, ENC_BIG_ENDIAN) : UINT16_MAX;
+
+	// Add index of the starting parameter byte
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_param_byte,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of parameter bytes
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_param_bytes,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add object server response if it's an error telegram
+	if (!nr_of_param_bytes && tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add parameter bytes
+	dissect_param_bytes(tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+}
+
+// Dissects SetParameterByteRes telegrams
+void
+dissect_set_parameter_byte_res(tvbuff_t *tvb, packet_info *pinfo _U_, proto_tree *baos_payload_tree, uint8_t start_byte_index)
+{
+	// Add index of the starting parameter byte
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 4))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_start_param_byte,
+							tvb,
+							BAOS_START_INDEX + 2,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Add number of parameter bytes
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 6))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_nr_of_param_bytes,
+							tvb,
+							BAOS_START_INDEX + 4,
+							2,
+							ENC_BIG_ENDIAN
+							);
+	}
+	// Object server response (Notification about success or error)
+	if (tvb->length >= (uint16_t)(BAOS_START_INDEX + 7))
+	{
+		proto_tree_add_item(
+							baos_payload_tree,
+							hf_baos_object_server_response,
+							tvb,
+							BAOS_START_INDEX + 6,
+							1,
+							ENC_BIG_ENDIAN
+							);
+	}
+}
+
+// Main function of the dissector
+static bool
+dissect_baos_heur(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_)
+{
+	proto_tree *baos_tree;
+
+	return dissect_baos_telegram(tvb, pinfo, tree, &baos_tree, true);
+}
+
+// Dissects a BAOS telegram, or an FT 1.2 acknowledgement or fixed length
+// frame of a device known to exchange BAOS telegrams.
+// Sets telegram_tree to the tree of the BAOS telegram,
+// so that the caller can add to it, or to NULL for other frames.
+// Only the outcome for USB transfers (is_heur) is handed to the heuristic taps.
+// Returns false if the TVB doesn't carry BAOS.
+static bool
+dissect_baos_telegram(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, proto_tree **telegram_tree, bool is_heur)
+{
+	*telegram_tree = NULL;
+
+	const bool is_heur_counted = is_heur && have_tap_listener(baos_heur_tap);
+
+	// It should not be possible for a
+	// serial BAOS telegram to be less than 10 bytes long.
+	if (tvb->length < 10)
+	{
+		// FT 1.2 acknowledgements and fixed length frames are only taken
+		// from devices already known to exchange BAOS telegrams, since
+		// a single byte would match transfers of any other device
+		const uint8_t link_frame_type = ft12_get_short_frame_type(tvb_get_ptr(tvb, 0, tvb->length), tvb->length);
+		if (link_frame_type != UINT8_MAX &&
+			(PINFO_FD_VISITED(pinfo) ?
+				p_get_proto_data(wmem_file_scope(), pinfo, proto_baos, pinfo->curr_layer_num) != NULL :
+				wmem_map_contains(baos_conv_data_map, GUINT_TO_POINTER(get_baos_device_key(pinfo, NULL)))))
+		{
+			dissect_ft12_link_frame(tvb, pinfo, tree, link_frame_type);
+			if (is_heur_counted)
+				queue_baos_heur_result(tvb, pinfo, BAOS_HEUR_ACCEPTED_LINK_FRAME);
+			return true;
+		}
+
+		if (is_heur_counted)
+			queue_baos_heur_result(tvb, pinfo, BAOS_HEUR_TOO_SHORT);
+		return false;
+	}
+
+	// When the frame is dissected again, e.g. when it's selected or
+	// filtered, the outcome of the heuristic on the first pass is reused.
+	// Every accepted telegram has its frame data stored on the first pass,
+	// so a transfer without it has been rejected and needs no marker.
+	const baos_frame_data_t *first_pass_data = PINFO_FD_VISITED(pinfo) ?
+						(const baos_frame_data_t *)p_get_proto_data(wmem_file_scope(), pinfo, proto_baos, pinfo->curr_layer_num) : NULL;
+
+	// A rejected transfer is only looked at again to count the reason
+	if (PINFO_FD_VISITED(pinfo) && !first_pass_data && !is_heur_counted)
+		return false;
+
+	// Store index of the FT 1.2 start byte in var if FT 1.2 + BAOS pattern found,
+	// or store UINT8_MAX in var if pattern has not been found.
+	const uint8_t start_byte_index = first_pass_data ?
+										first_pass_data->start_byte_index : check_serial_baos_pattern(tvb);
+
+	// Returns false and ends dissection routine
+	// if FT 1.2 + BAOS pattern has not been found
+	if (start_byte_index == UINT8_MAX)
+	{
+		// Only look for the reason if it's going to be counted
+		if (is_heur_counted)
+			queue_baos_heur_result(tvb, pinfo, get_baos_heur_reject_reason(tvb));
+		return false;
+	}
+
+	// The FT 1.2 length covers at least the control byte,
+	// the BAOS main service and the subservice
+	if (tvb_get_uint8(tvb, start_byte_index + 1) < 3)
+	{
+		if (is_heur_counted)
+			queue_baos_heur_result(tvb, pinfo, BAOS_HEUR_BAD_LENGTH);
+		return false;
+	}
+
+	//
+	// From here onwards we can assume that
+	// a serial BAOS telegram has been found
+	//
+
+	// Stores length of the BAOS payload in var.
+	// Checksum byte needs to be subtracted.
+	const uint8_t baos_payload_len = tvb_get_uint8(tvb, start_byte_index + 1) - 1;
+
+	// Calculate and store index of the start of the FT 1.2 trailer
+	const uint16_t trailer_start_index = start_byte_index + 5 + baos_payload_len;
+
+	// The subservices are dissected from a TVB ending with the BAOS payload,
+	// so that neither the FT 1.2 trailer nor further bytes of the USB transfer
+	// are taken for items, and loops end with the bytes actually captured
+	tvbuff_t *payload_tvb = tvb_new_subset_length(tvb, 0, MIN(trailer_start_index, tvb_reported_length(tvb)));
+
+	// Label handled telegrams as "BAOS Telegram"
+	col_set_str(pinfo->cinfo, COL_INFO, "BAOS Telegram");
+
+	// Base BAOS tree
+	proto_item *baos_ti = proto_tree_add_item(
+												tree,
+												proto_baos,
+												tvb,
+												start_byte_index,
+												-1,
+												ENC_NA
+												);
+	proto_tree *baos_tree = proto_item_add_subtree(baos_ti, ett_baos);
+	*telegram_tree = baos_tree;
+
+	// FT 1.2 frame subtree
+	proto_item *ft12_ti = proto_tree_add_item(
+												baos_tree,
+												hf_baos_ft12,
+												tvb,
+												start_byte_index,
+												5,
+												ENC_NA
+												);
+	proto_tree *ft12_tree = proto_item_add_subtree(ft12_ti, ett_ft12);
+
+	// FT 1.2 header subtree
+	proto_item *ft12_header_ti = proto_tree_add_item(
+													ft12_tree,
+													hf_baos_ft12_header,
+													tvb,
+													start_byte_index,
+													5,
+													ENC_NA
+													);
+	proto_tree *ft12_header_tree = proto_item_add_subtree(ft12_header_ti, ett_ft12_header);
+
+	// Add FT 1.2 header items
+	proto_tree_add_item(
+						ft12_header_tree,
+						hf_baos_ft12_startbyte,
+						tvb,
+						start_byte_index,
+						1,
+						ENC_BIG_ENDIAN
+						);
+	proto_tree_add_item(
+						ft12_header_tree,
+	 					hf_baos_ft12_lengthbyte,
+					 	tvb,
+					 	start_byte_index + 1,
+					  	1,
+						ENC_BIG_ENDIAN
+						);
+	proto_tree_add_item(
+						ft12_header_tree,
+	 					hf_baos_ft12_lengthbyte,
+					 	tvb,
+					 	start_byte_index + 2,
+					  	1,
+						ENC_BIG_ENDIAN
+						);
+	proto_tree_add_item(
+						ft12_header_tree,
+	 					hf_baos_ft12_startbyte,
+					 	tvb,
+					 	start_byte_index + 3,
+					  	1,
+						ENC_BIG_ENDIAN
+						);
+	proto_tree_add_item(
+						ft12_header_tree,
+	 					hf_baos_ft12_controllbyte,
+					 	tvb,
+					 	start_byte_index + 4,
+					  	1,
+						ENC_BIG_ENDIAN
+						);
+
+	// BAOS payload subtree
+	proto_item *baos_payload_ti = proto_tree_add_item(
+													ft12_tree,
+													hf_baos_baos_payload,
+													tvb,
+													BAOS_START_INDEX,
+													-1,
+													ENC_NA
+													);
+	proto_tree *baos_payload_tree = proto_item_add_subtree(baos_payload_ti, ett_baos_payload);
+
+	// Add common BAOS payload data
+	proto_tree_add_item(
+						baos_payload_tree,
+						hf_baos_baos_mainservice,
+						tvb,
+						BAOS_START_INDEX,
+						1,
+						ENC_BIG_ENDIAN
+						);
+	proto_tree_add_item(
+						baos_payload_tree,
+						hf_baos_baos_subservice,
+						tvb,
+						BAOS_START_INDEX + 1,
+						1,
+						ENC_BIG_ENDIAN
+						);
+
+	//
+	// From here onwards, the dissection depends on the subservice
+	//
+
+	// Store BAOS subservice code in var
+	const uint8_t baos_subservice_code = tvb_get_uint8(tvb, BAOS_START_INDEX + 1);
+
+	// Setup information about the telegram shared by
+	// the sub-dissectors and handed to the taps
+	baos_info_t *baos_info = wmem_new0(pinfo->pool, baos_info_t);
+	baos_info->subservice = baos_subservice_code;
+	baos_info->conv_data = get_baos_conv_data(pinfo);
+	baos_info->frame_data = get_baos_frame_data(pinfo, baos_info->conv_data);
+	baos_info->frame_data->start_byte_index = start_byte_index;
+	baos_info->frame_data->telegram_length = baos_payload_len + 7;
+
+	// Match responses with their requests
+	match_baos_transaction(pinfo, baos_info);
+	dissect_transaction_info(tvb, baos_payload_tree, baos_info);
+
+	if (!PINFO_FD_VISITED(pinfo))
+		check_stuck_transmissions(pinfo, baos_info->conv_data);
+
+	if (baos_info->frame_data->is_over_budget)
+		proto_tree_add_expert(baos_payload_tree, pinfo, &ei_baos_state_budget, tvb, start_byte_index, 0);
+
+	// Link the frame with its FT 1.2 acknowledgement
+	match_ft12_ack(pinfo, baos_info->conv_data, baos_info->frame_data, FT12_VARIABLE_FRAME, tvb_get_uint8(tvb, start_byte_index + 4));
+	dissect_ft12_ack_info(tvb, ft12_tree, baos_info->frame_data);
+
+	// Call dissector function of the corresponding
+	// subservice based on the found subservice code
+	switch (baos_subservice_code)
+	{
+		case GET_SERVER_ITEM_REQ_CODE:
+			dissect_get_server_item_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index);
+			break;
+		case SET_SERVER_ITEM_REQ_CODE:
+			dissect_long_server_item_telegram(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_DATAPOINT_DESC_REQ_CODE:
+			dissect_get_datapoint_desc_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index);
+			break;
+		case GET_DESC_STRING_REQ_CODE:
+			dissect_get_desc_string_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index);
+			break;
+		case GET_DATAPOINT_VALUE_REQ_CODE:
+			dissect_get_datapoint_value_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case SET_DATAPOINT_VALUE_REQ_CODE:
+			dissect_set_datapoint_value_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_PARAMETER_BYTE_REQ_CODE:
+			dissect_get_parameter_byte_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index);
+			break;
+		case SET_PARAMETER_BYTE_REQ_CODE:
+			dissect_set_parameter_byte_req(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_SERVER_ITEM_RES_CODE:
+			dissect_long_server_item_telegram(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case SET_SERVER_ITEM_RES_CODE:
+			dissect_set_server_item_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_DATAPOINT_DESC_RES_CODE:
+			dissect_get_datapoint_desc_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_DESC_STRING_RES_CODE:
+			dissect_get_desc_string_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_DATAPOINT_VALUE_RES_CODE:
+			dissect_get_datapoint_value_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case SET_DATAPOINT_VALUE_RES_CODE:
+			dissect_set_datapoint_value_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case GET_PARAMETER_BYTE_RES_CODE:
+			dissect_get_parameter_byte_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case SET_PARAMETER_BYTE_RES_CODE:
+			dissect_set_parameter_byte_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index);
+			break;
+		case DATAPOINT_VALUE_IND_CODE:
+			dissect_get_datapoint_value_res(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		case SERVER_ITEM_IND_CODE:
+			dissect_long_server_item_telegram(payload_tvb, pinfo, baos_payload_tree, start_byte_index, baos_info);
+			break;
+		default:
+			break;
+	}
+
+	// Check BAOS payload length against the buffer size of the device
+	dissect_buffer_utilization(tvb, pinfo, baos_payload_tree, baos_payload_len, baos_info);
+
+	//
+	// Dissection of the FT 1.2 trailer
+	//
+
+	// Check if FT 1.2 frame is complete and store result in var
+	const bool is_frame_complete = check_packet_integrity(tvb, trailer_start_index);
+
+	// Outcome of the heuristic, refined by the FT 1.2 trailer
+	uint8_t heur_result = BAOS_HEUR_ACCEPTED;
+
+	// Add ExpertInfo if FT 1.2 endbyte not found,
+	// meaning frame is likely incomplete
+	if (!is_frame_complete)
+	{
+		expert_add_info(pinfo, ft12_ti, &ei_ft12_incomplete_frame);
+		heur_result = BAOS_HEUR_ACCEPTED_INCOMPLETE;
+	}
+
+	// Build FT 1.2 trailer subtree if at least
+	// first byte of the trailer is in TVB
+	if (tvb->length >= (uint16_t)(trailer_start_index + 1))
+	{
+		// FT 1.2 trailer subtree, which may end with the checksum
+		proto_item *ft12_trailer_ti = proto_tree_add_item(
+														ft12_tree,
+														hf_baos_ft12_trailer,
+														tvb,
+														trailer_start_index,
+														MIN(FT12_TRAILER_LENGTH, tvb->length - trailer_start_index),
+														ENC_NA
+														);
+		proto_tree *ft12_trailer_tree = proto_item_add_subtree(ft12_trailer_ti, ett_ft12_trailer);
+
+		// Define var for checksum found in telegram
+		uint32_t ft12_checksum = 0;
+		// Store calculated checksum of the packet,
+		// which is calculated only once per frame
+		if (!baos_info->frame_data->is_checksum_known)
+		{
+			baos_info->frame_data->checksum = (uint8_t)calculateChecksum(tvb, start_byte_index, trailer_start_index);
+			baos_info->frame_data->is_checksum_known = true;
+		}
+		const uint32_t calculated_checksum = baos_info->frame_data->checksum;
+
+		// Add FT 1.2 checksum to tree structure
+		// and store the value in "ft12_checksum"
+		proto_tree_add_item_ret_uint(
+							ft12_trailer_tree,
+							hf_baos_ft12_checksum,
+							tvb,
+							trailer_start_index,
+							1,
+							ENC_BIG_ENDIAN,
+							&ft12_checksum
+							);
+
+		// Add ExpertInfo if found checksum doesn't match
+		// calculated expected checksum
+		if (ft12_checksum != calculated_checksum)
+		{
+			expert_add_info_format(pinfo, ft12_ti, &ei_ft12_checksum_error, "Expected checksum: 0x%x Found checksum: 0x%x", calculated_checksum, ft12_checksum);
+			if (is_frame_complete)
+				heur_result = BAOS_HEUR_ACCEPTED_CHECKSUM_ERROR;
+		}
+		if (tvb->length >= trailer_start_index + 2u)
+		{
+			// Add FT 1.2 endbyte
+			proto_tree_add_item(
+								ft12_trailer_tree,
+								hf_baos_ft12_endbyte,
+								tvb,
+								trailer_start_index + 1,
+								1,
+								ENC_BIG_ENDIAN
+								);
+		}
+	}
+
+	// Show the outcome of the heuristic if requested
+	if (pref_heur_result_field)
+	{
+		proto_item *heur_result_ti = proto_tree_add_uint(
+														baos_tree,
+														hf_baos_heur_result,
+														tvb,
+														start_byte_index,
+														0,
+														heur_result
+														);
+		proto_item_set_generated(heur_result_ti);
+	}
+
+	tap_queue_packet(baos_tap, pinfo, baos_info);
+	if (is_heur_counted)
+		queue_baos_heur_result(tvb, pinfo, heur_result);
+
+	return true;
+}
+
+// Dissects FT 1.2 frames captured from a serial line, e.g. by the
+// baosserialdump extcap, where every record holds a single frame.
+// Records starting in the middle of a frame or with bytes
+// of a broken frame are resynchronized to the first valid frame.
+// Returns the number of bytes up to the end of the frame,
+// or 0 if it doesn't carry BAOS.
+static int
+dissect_baos_ft12(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_)
+{
+	tvbuff_t *frame_tvb = tvb;
+	proto_tree *baos_tree;
+	uint32_t skipped_bytes = 0;
+
+	const unsigned record_length = tvb_captured_length(tvb);
+	const uint8_t link_frame_type = ft12_get_short_frame_type(tvb_get_ptr(tvb, 0, record_length), record_length);
+	if (link_frame_type != UINT8_MAX)
+	{
+		col_set_str(pinfo->cinfo, COL_PROTOCOL, "BAOS");
+		return dissect_ft12_link_frame(tvb, pinfo, tree, link_frame_type);
+	}
+
+	if (check_serial_baos_pattern(tvb) == UINT8_MAX)
+	{
+		ft12_scanner_t scanner;
+		ft12_scan_result_t frame;
+		size_t length = tvb_captured_length(tvb);
+		const uint8_t *bytes = tvb_get_ptr(tvb, 0, (int)length);
+
+		// The record is complete, so the scanner doesn't have to wait for more
+		ft12_scanner_init(&scanner);
+		ft12_scanner_finish(&scanner);
+
+		bool is_baos_found = false;
+		while (!is_baos_found && ft12_scanner_next(&scanner, &bytes, &length, &frame))
+			is_baos_found = ft12_is_baos_pattern_at(frame.bytes, frame.length, 0);
+
+		if (!is_baos_found)
+			return 0;
+
+		skipped_bytes = (uint32_t)frame.offset;
+		frame_tvb = tvb_new_subset_length(tvb, skipped_bytes, frame.length);
+	}
+
+	if (!dissect_baos_telegram(frame_tvb, pinfo, tree, &baos_tree, false))
+		return 0;
+
+	col_set_str(pinfo->cinfo, COL_PROTOCOL, "BAOS");
+
+	// The skipped bytes are shown in the tree of the telegram
+	// they precede, from the TVB of the whole record
+	if (skipped_bytes)
+	{
+		proto_item *skipped_ti = proto_tree_add_item(
+														baos_tree,
+														hf_baos_ft12_skipped,
+														tvb,
+														0,
+														skipped_bytes,
+														ENC_NA
+														);
+		expert_add_info_format(
+								pinfo,
+								skipped_ti,
+								&ei_ft12_resync,
+								"Resynchronized after %u bytes not belonging to any FT 1.2 frame",
+								skipped_bytes
+								);
+	}
+	return (int)(skipped_bytes + tvb_captured_length(frame_tvb));
+}
+
+// Resets the state of the dissector when a new capture file is opened
+void
+baos_init(void)
+{
+	baos_device_count = 0;
+
+}
+
+// Loads the datapoint catalog when the preferences have changed
+// and registers the value fields of its datapoints
+void
+apply_baos_prefs(void)
+{
+	if (load_dp_catalog(true))
+		register_dp_value_fields();
+}
+
+//
+// Statistics
+//
+
+static int st_node_devices = -1;
+static const char *st_str_devices = "BAOS devices";
+
+// Initializes the device inventory statistics tree
+void
+baos_devices_stats_tree_init(stats_tree *st)
+{
+	st_node_devices = stats_tree_create_node(st, st_str_devices, 0, STAT_DT_INT, true);
+}
+
+// Sets a property of a device in the device inventory statistics tree.
+// The property node keeps its name and gets the value as its sub-node,
+// so that properties aren't listed again with every value they take.
+void
+set_device_property_stat_node(stats_tree *st, int device_node, const char *property, const char *value)
+{
+	const int property_node = set_stat_node(st, property, device_node, true, 1);
+	set_stat_node(st, value, property_node, false, 1);
+}
+
+// Adds the device profile of the device, which sent the server items
+// of the telegram, to the device inventory statistics tree
+tap_packet_status
+baos_devices_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	if (baos_info->subservice != GET_SERVER_ITEM_RES_CODE && baos_info->subservice != SERVER_ITEM_IND_CODE)
+		return TAP_PACKET_DONT_REDRAW;
+
+	const baos_device_profile_t *device_profile = &baos_info->conv_data->device_profile;
+	const uint32_t known_server_items = device_profile->known_server_items;
+
+	if (!known_server_items)
+		return TAP_PACKET_DONT_REDRAW;
+
+	// Count every device once, in the first telegram that told about it
+	if (device_profile->first_frame == pinfo->num)
+		tick_stat_node(st, st_str_devices, 0, false);
+	const int device_node = set_stat_node(st, baos_info->conv_data->name, st_node_devices, true, 1);
+
+	if (known_server_items & (1u << HARDWARE_TYPE))
+		set_device_property_stat_node(st, device_node, "Hardware type",
+							wmem_strdup_printf(pinfo->pool, "%02X %02X %02X %02X %02X %02X",
+							device_profile->hardware_type[0], device_profile->hardware_type[1],
+							device_profile->hardware_type[2], device_profile->hardware_type[3],
+							device_profile->hardware_type[4], device_profile->hardware_type[5]));
+	if (known_server_items & (1u << HARDWARE_VERSION))
+		set_device_property_stat_node(st, device_node, "Hardware version",
+							wmem_strdup_printf(pinfo->pool, "%u.%u",
+							device_profile->hardware_version >> 4, device_profile->hardware_version & 0x0F));
+	if (known_server_items & (1u << FIRMWARE_VERSION))
+		set_device_property_stat_node(st, device_node, "Firmware version",
+							wmem_strdup_printf(pinfo->pool, "%u.%u",
+							device_profile->firmware_version >> 4, device_profile->firmware_version & 0x0F));
+	if (known_server_items & (1u << KNX_MANUFACTURER_CODE_DEV))
+		set_device_property_stat_node(st, device_node, "KNX manufacturer code (device)",
+							wmem_strdup_printf(pinfo->pool, "0x%04x", device_profile->knx_man_code_dev));
+	if (known_server_items & (1u << KNX_MANUFACTURER_CODE_APP))
+		set_device_property_stat_node(st, device_node, "KNX manufacturer code (application)",
+							wmem_strdup_printf(pinfo->pool, "0x%04x", device_profile->knx_man_code_app));
+	if (known_server_items & (1u << APPLICATION_ID_ETS))
+		set_device_property_stat_node(st, device_node, "Application ID",
+							wmem_strdup_printf(pinfo->pool, "0x%04x", device_profile->app_id));
+	if (known_server_items & (1u << APPLICATION_VERSION_ETS))
+		set_device_property_stat_node(st, device_node, "Application version",
+							wmem_strdup_printf(pinfo->pool, "%u.%u",
+							device_profile->app_version >> 4, device_profile->app_version & 0x0F));
+	if (known_server_items & (1u << SERIAL_NUMBER))
+		set_device_property_stat_node(st, device_node, "Serial number",
+							wmem_strdup_printf(pinfo->pool, "%02X%02X:%02X%02X%02X%02X",
+							device_profile->serial_number[0], device_profile->serial_number[1],
+							device_profile->serial_number[2], device_profile->serial_number[3],
+							device_profile->serial_number[4], device_profile->serial_number[5]));
+	// The buffer size is shown as the count of its node
+	if (known_server_items & (1u << MAX_BUFFER_SIZE))
+		set_stat_node(st, "Maximum buffer size [bytes]", device_node, false, device_profile->max_buffer_size);
+	if (known_server_items & (1u << INDIVIDUAL_ADDRESS))
+		set_device_property_stat_node(st, device_node, "Individual address",
+							wmem_strdup_printf(pinfo->pool, "%u.%u.%u",
+							device_profile->individual_address >> 12,
+							(device_profile->individual_address >> 8) & 0x0F,
+							device_profile->individual_address & 0xFF));
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_buffer = -1;
+static const char *st_str_buffer = "BAOS payload / buffer size [%]";
+
+// Initializes the buffer utilization statistics tree
+void
+baos_buffer_stats_tree_init(stats_tree *st)
+{
+	st_node_buffer = stats_tree_create_range_node(
+													st,
+													st_str_buffer,
+													0,
+													"0 - 24",
+													"25 - 49",
+													"50 - 74",
+													"75 - 89",
+													"90 - 100",
+													"101 - ",
+													NULL
+													);
+}
+
+// Adds the buffer utilization of the telegram to the histogram
+// of the buffer utilization statistics tree
+tap_packet_status
+baos_buffer_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	if (baos_info->buffer_utilization < 0)
+		return TAP_PACKET_DONT_REDRAW;
+
+	tick_stat_node(st, st_str_buffer, 0, false);
+	stats_tree_tick_range(st, st_str_buffer, 0, baos_info->buffer_utilization);
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_polls = -1;
+static const char *st_str_polls = "GetDatapointValue polls";
+
+// Initializes the polling efficiency statistics tree
+void
+baos_poll_stats_tree_init(stats_tree *st)
+{
+	st_node_polls = stats_tree_create_node(st, st_str_polls, 0, STAT_DT_INT, true);
+}
+
+// Adds the polling analysis of GetDatapointValue telegrams
+// to the polling efficiency statistics tree of the device
+tap_packet_status
+baos_poll_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+	const baos_poll_result_t *poll = baos_info->frame_data->poll;
+
+	if (!poll)
+		return TAP_PACKET_DONT_REDRAW;
+
+	if (baos_info->subservice == GET_DATAPOINT_VALUE_REQ_CODE)
+	{
+		tick_stat_node(st, st_str_polls, 0, false);
+		const int device_node = tick_stat_node(st, baos_info->conv_data->name, st_node_polls, true);
+
+		tick_stat_node(st, val_to_str_const(poll->filter, vs_dp_filters, "Unknown filter"), device_node, false);
+		if (poll->flags & BAOS_POLL_OVERLAP)
+			tick_stat_node(st, "Overlapping polls", device_node, false);
+		if (poll->flags & BAOS_POLL_REPEATED)
+			tick_stat_node(st, "Repeated polls without changes", device_node, false);
+	}
+	else
+	{
+		const int device_node = increase_stat_node(st, baos_info->conv_data->name, st_node_polls, true, 0);
+
+		increase_stat_node(st, "Returned datapoints", device_node, false, poll->returned_dps);
+		increase_stat_node(st, "Changed datapoints", device_node, false, poll->changed_dps);
+		increase_stat_node(st, "Unchanged datapoints", device_node, false, poll->returned_dps - poll->changed_dps);
+		increase_stat_node(st, "Wasted bytes", device_node, false, poll->wasted_bytes);
+		if (!poll->changed_dps)
+			tick_stat_node(st, "Polls without changes", device_node, false);
+	}
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_trans = -1;
+static const char *st_str_trans = "Completed transmissions [ms]";
+static const char *st_str_trans_ok = "Ended with Idle/OK";
+static const char *st_str_trans_error = "Ended with Idle/error";
+static const char *st_str_trans_stuck = "Stuck transmission observations";
+
+// Initializes the transmission latency statistics tree
+void
+baos_trans_stats_tree_init(stats_tree *st)
+{
+	st_node_trans = stats_tree_create_range_node(
+												st,
+												st_str_trans,
+												0,
+												"0 - 9",
+												"10 - 49",
+												"50 - 99",
+												"100 - 499",
+												"500 - 999",
+												"1000 - 4999",
+												"5000 - ",
+												NULL
+												);
+	stats_tree_create_node(st, st_str_trans_ok, st_node_trans, STAT_DT_INT, false);
+	stats_tree_create_node(st, st_str_trans_error, st_node_trans, STAT_DT_INT, false);
+	stats_tree_create_node(st, st_str_trans_stuck, 0, STAT_DT_INT, false);
+}
+
+// Adds a single datapoint transmission to the statistics tree
+void
+baos_trans_stats_tree_tick(void *key _U_, void *value, void *userdata)
+{
+	stats_tree *st = (stats_tree *)userdata;
+	const baos_dp_transmission_t *transmission = (const baos_dp_transmission_t *)value;
+
+	if (transmission->is_stuck)
+		tick_stat_node(st, st_str_trans_stuck, 0, false);
+
+	if (!transmission->is_complete)
+		return;
+
+	tick_stat_node(st, st_str_trans, 0, false);
+	stats_tree_tick_range(st, st_str_trans, 0, (int)nstime_to_msec(&transmission->duration));
+	tick_stat_node(st, transmission->trans_state == IDLE_OK ? st_str_trans_ok : st_str_trans_error, st_node_trans, false);
+}
+
+// Adds the datapoint transmissions that ended or got
+// stuck in the telegram to the latency histogram
+tap_packet_status
+baos_trans_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	if (!baos_info->frame_data->dp_transmissions)
+		return TAP_PACKET_DONT_REDRAW;
+
+	wmem_map_foreach(baos_info->frame_data->dp_transmissions, baos_trans_stats_tree_tick, st);
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_writes = -1;
+static int st_node_writes_per_dp = -1;
+static const char *st_str_writes = "Writes per command";
+static const char *st_str_writes_per_dp = "Confirmed writes per datapoint";
+static const char *st_str_write_res_time = "Request to response [ms]";
+static const char *st_str_write_ind_time = "Response to indication [ms]";
+static const char *st_str_write_latency = "Request to indication [ms]";
+
+// Initializes the write latency statistics tree
+void
+baos_write_stats_tree_init(stats_tree *st)
+{
+	st_node_writes = stats_tree_create_node(st, st_str_writes, 0, STAT_DT_INT, true);
+	st_node_writes_per_dp = stats_tree_create_node(st, st_str_writes_per_dp, 0, STAT_DT_INT, true);
+}
+
+// Adds the legs of a single datapoint write to the statistics tree
+void
+baos_write_stats_tree_tick(void *key _U_, void *value, void *userdata)
+{
+	const baos_write_stats_ctx_t *ctx = (const baos_write_stats_ctx_t *)userdata;
+	const baos_dp_write_t *dp_write = (const baos_dp_write_t *)value;
+	stats_tree *st = ctx->st;
+	nstime_t leg_time;
+
+	const char *command = val_to_str_const(dp_write->command, vs_dp_commands, "Unknown command");
+
+	// Count writes where they are requested
+	if (dp_write->req_frame == ctx->pinfo->num)
+	{
+		tick_stat_node(st, st_str_writes, 0, false);
+		tick_stat_node(st, command, st_node_writes, true);
+		return;
+	}
+
+	// Add the legs where the write is confirmed
+	if (dp_write->ind_frame != ctx->pinfo->num)
+		return;
+
+	const int command_node = increase_stat_node(st, command, st_node_writes, true, 0);
+	tick_stat_node(st, "Confirmed", command_node, false);
+	tick_stat_node(st, st_str_writes_per_dp, 0, false);
+	const int dp_node = tick_stat_node(
+										st,
+										get_dp_label(ctx->pinfo, ctx->baos_info->conv_data, dp_write->dp_id),
+										st_node_writes_per_dp,
+										true
+										);
+
+	if (dp_write->res_frame)
+	{
+		nstime_delta(&leg_time, &dp_write->res_ts, &dp_write->req_ts);
+		avg_stat_node_add_value_float(st, st_str_write_res_time, command_node, false, (float)nstime_to_msec(&leg_time));
+		avg_stat_node_add_value_float(st, st_str_write_res_time, dp_node, false, (float)nstime_to_msec(&leg_time));
+
+	}
+	if (dp_write->res_frame && nstime_cmp(&dp_write->ind_ts, &dp_write->res_ts) >= 0)
+	{
+		nstime_delta(&leg_time, &dp_write->ind_ts, &dp_write->res_ts);
+		avg_stat_node_add_value_float(st, st_str_write_ind_time, command_node, false, (float)nstime_to_msec(&leg_time));
+		avg_stat_node_add_value_float(st, st_str_write_ind_time, dp_node, false, (float)nstime_to_msec(&leg_time));
+	}
+	nstime_delta(&leg_time, &dp_write->ind_ts, &dp_write->req_ts);
+	avg_stat_node_add_value_float(st, st_str_write_latency, command_node, false, (float)nstime_to_msec(&leg_time));
+	avg_stat_node_add_value_float(st, st_str_write_latency, dp_node, false, (float)nstime_to_msec(&leg_time));
+}
+
+// Adds the datapoint writes requested or confirmed
+// in the telegram to the write latency statistics tree
+tap_packet_status
+baos_write_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	// Responses share the writes of their request
+	if (!baos_info->frame_data->dp_writes || baos_info->subservice == SET_DATAPOINT_VALUE_RES_CODE)
+		return TAP_PACKET_DONT_REDRAW;
+
+	baos_write_stats_ctx_t ctx = { st, baos_info, pinfo };
+	wmem_map_foreach(baos_info->frame_data->dp_writes, baos_write_stats_tree_tick, &ctx);
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_bus_load = -1;
+static int st_node_bus_load_devices = -1;
+static const char *st_str_bus_load = "DatapointValue.Ind by bus load [1/s]";
+static const char *st_str_bus_load_devices = "Bus load per device";
+static const char *st_str_bus_load_peak = "Peak bus load [1/s]";
+static const char *st_str_bus_load_distinct_dps = "Distinct datapoints in window";
+static const char *st_str_bus_storms = "Bus storm indications";
+
+// Initializes the bus load statistics tree
+void
+baos_bus_load_stats_tree_init(stats_tree *st)
+{
+	st_node_bus_load = stats_tree_create_range_node(
+													st,
+													st_str_bus_load,
+													0,
+													"0 - 9",
+													"10 - 19",
+													"20 - 49",
+													"50 - 99",
+													"100 - ",
+													NULL
+													);
+	st_node_bus_load_devices = stats_tree_create_node(st, st_str_bus_load_devices, 0, STAT_DT_INT, true);
+}
+
+// Adds the bus load estimated for a DatapointValue.Ind
+// to the histogram and to the peaks of the device
+tap_packet_status
+baos_bus_load_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+	const baos_bus_load_t *bus_load = baos_info->frame_data->bus_load;
+
+	if (!bus_load)
+		return TAP_PACKET_DONT_REDRAW;
+
+	tick_stat_node(st, st_str_bus_load, 0, false);
+	stats_tree_tick_range(st, st_str_bus_load, 0, (int)bus_load->rate);
+
+	tick_stat_node(st, st_str_bus_load_devices, 0, false);
+	const int device_node = tick_stat_node(st, baos_info->conv_data->name, st_node_bus_load_devices, true);
+	set_stat_node(st, st_str_bus_load_peak, device_node, false, (int)bus_load->peak_rate);
+	avg_stat_node_add_value_float(st, st_str_bus_load_distinct_dps, device_node, false, (float)bus_load->distinct_dps);
+	if (bus_load->is_storm)
+		tick_stat_node(st, st_str_bus_storms, device_node, false);
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_acks = -1;
+static int st_node_ack_latency_device = -1;
+static int st_node_ack_latency_host = -1;
+static int st_node_ack_latency_per_device = -1;
+static const char *st_str_acks = "Acknowledgements";
+static const char *st_str_acks_positive = "Positive";
+static const char *st_str_acks_negative = "Negative";
+static const char *st_str_acks_unmatched = "Without acknowledged frame";
+static const char *st_str_ack_latency_device = "Acknowledged by the device [ms]";
+static const char *st_str_ack_latency_host = "Acknowledged by the host [ms]";
+static const char *st_str_ack_latency_per_device = "Acknowledgement latency per device [ms]";
+
+// Initializes the link layer latency statistics tree
+void
+baos_ack_stats_tree_init(stats_tree *st)
+{
+	st_node_acks = stats_tree_create_node(st, st_str_acks, 0, STAT_DT_INT, true);
+	st_node_ack_latency_device = stats_tree_create_range_node(
+																st,
+																st_str_ack_latency_device,
+																0,
+																"0 - 1",
+																"2 - 4",
+																"5 - 9",
+																"10 - 19",
+																"20 - 49",
+																"50 - 99",
+																"100 - ",
+																NULL
+																);
+	st_node_ack_latency_host = stats_tree_create_range_node(
+																st,
+																st_str_ack_latency_host,
+																0,
+																"0 - 1",
+																"2 - 4",
+																"5 - 9",
+																"10 - 19",
+																"20 - 49",
+																"50 - 99",
+																"100 - ",
+																NULL
+																);
+	st_node_ack_latency_per_device = stats_tree_create_node(st, st_str_ack_latency_per_device, 0, STAT_DT_INT, true);
+}
+
+// Adds an FT 1.2 acknowledgement to the latency histogram
+// of the station that sent it
+tap_packet_status
+baos_ack_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_ack_info_t *ack_info = (const baos_ack_info_t *)p;
+	const baos_frame_data_t *acked_frame_data = ack_info->frame_data->ack;
+	nstime_t ack_latency;
+
+	tick_stat_node(st, st_str_acks, 0, false);
+	tick_stat_node(st, ack_info->is_negative ? st_str_acks_negative : st_str_acks_positive, st_node_acks, false);
+
+	if (!acked_frame_data)
+	{
+		tick_stat_node(st, st_str_acks_unmatched, st_node_acks, false);
+		return TAP_PACKET_REDRAW;
+	}
+
+	// Frames of the device are acknowledged by the host and vice versa
+	const char *latency_node_name = acked_frame_data->is_from_device ? st_str_ack_latency_host : st_str_ack_latency_device;
+	nstime_delta(&ack_latency, &ack_info->frame_data->abs_ts, &acked_frame_data->abs_ts);
+
+	tick_stat_node(st, latency_node_name, 0, false);
+	stats_tree_tick_range(st, latency_node_name, 0, (int)nstime_to_msec(&ack_latency));
+
+	tick_stat_node(st, st_str_ack_latency_per_device, 0, false);
+	avg_stat_node_add_value_float(st, ack_info->conv_data->name, st_node_ack_latency_per_device, false, (float)nstime_to_msec(&ack_latency));
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_heur = -1;
+static int st_node_heur_rejected = -1;
+static int st_node_heur_accepted = -1;
+static const char *st_str_heur = "Heuristic invocations";
+static const char *st_str_heur_rejected = "Rejected";
+static const char *st_str_heur_accepted = "Accepted";
+
+// Initializes the heuristic statistics tree
+void
+baos_heur_stats_tree_init(stats_tree *st)
+{
+	st_node_heur = stats_tree_create_node(st, st_str_heur, 0, STAT_DT_INT, true);
+	st_node_heur_rejected = stats_tree_create_node(st, st_str_heur_rejected, st_node_heur, STAT_DT_INT, true);
+	st_node_heur_accepted = stats_tree_create_node(st, st_str_heur_accepted, st_node_heur, STAT_DT_INT, true);
+}
+
+// Counts an outcome of the heuristic
+tap_packet_status
+baos_heur_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_heur_info_t *heur_info = (const baos_heur_info_t *)p;
+	const bool is_accepted = heur_info->result >= BAOS_HEUR_ACCEPTED;
+
+	tick_stat_node(st, st_str_heur, 0, false);
+	tick_stat_node(st, is_accepted ? st_str_heur_accepted : st_str_heur_rejected, st_node_heur, false);
+	tick_stat_node(
+					st,
+					val_to_str_const(heur_info->result, vs_baos_heur_results, "Unknown"),
+					is_accepted ? st_node_heur_accepted : st_node_heur_rejected,
+					false
+					);
+
+	return TAP_PACKET_REDRAW;
+}
+
+static int st_node_mem = -1;
+static const char *st_str_mem = "BAOS state [bytes]";
+static const char *st_str_mem_evictions = "Evicted datapoint histories";
+static const char *st_str_mem_over_budget = "Telegrams not analyzed (budget used up)";
+
+// Initializes the memory usage statistics tree
+void
+baos_mem_stats_tree_init(stats_tree *st)
+{
+	st_node_mem = stats_tree_create_node(st, st_str_mem, 0, STAT_DT_INT, true);
+}
+
+// Adds up the memory used by the state of a device
+void
+sum_baos_mem_usage(void *key _U_, void *value, void *userdata)
+{
+	size_t *total = (size_t *)userdata;
+
+	*total += get_baos_mem_usage((const baos_conv_data_t *)value);
+}
+
+// Shows the memory used by the state of the device the telegram
+// is exchanged with, by category, and by the state of all devices
+tap_packet_status
+baos_mem_stats_tree_packet(stats_tree *st, packet_info *pinfo _U_, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+	const baos_conv_data_t *conv_data = baos_info->conv_data;
+
+	size_t total = 0;
+	wmem_map_foreach(baos_conv_data_map, sum_baos_mem_usage, &total);
+	set_stat_node(st, st_str_mem, 0, true, (int)MIN(total, INT_MAX));
+
+	const size_t device_total = get_baos_mem_usage(conv_data);
+	const int device_node = set_stat_node(st, conv_data->name, st_node_mem, true, (int)MIN(device_total, INT_MAX));
+	for (int category = 0; category < BAOS_MEM_NR_OF_CATEGORIES; category++)
+	{
+		set_stat_node(
+						st,
+						val_to_str_const(category, vs_baos_mem_categories, "Unknown"),
+						device_node,
+						false,
+						(int)MIN(conv_data->mem_usage[category], INT_MAX)
+						);
+	}
+	set_stat_node(st, st_str_mem_evictions, device_node, false, (int)conv_data->dp_history_evictions);
+	set_stat_node(st, st_str_mem_over_budget, device_node, false, (int)conv_data->frames_over_budget);
+
+	return TAP_PACKET_REDRAW;
+}
+
+//
+// Datapoint value export
+//
+
+// Appends a field to a CSV row, quoted if necessary
+void
+baos_dp_export_append_field(GString *buffer, const char *field)
+{
+	if (!strpbrk(field, ",\"\r\n"))
+	{
+		g_string_append(buffer, field);
+		return;
+	}
 
-	// BAOS payload subtree
-	proto_item *baos_payload_ti = proto_tree_add_item(
-													ft12_tree,
-													hf_baos_baos_payload,
-													tvb,
-													BAOS_START_INDEX,
-													-1,
-													ENC_NA
-													);
-	proto_tree *baos_payload_tree = proto_item_add_subtree(baos_payload_ti, ett_baos_payload);
+	g_string_append_c(buffer, '"');
+	for (const char *c = field; *c; c++)
+	{
+		if (*c == '"')
+			g_string_append_c(buffer, '"');
+		g_string_append_c(buffer, *c);
+	}
+	g_string_append_c(buffer, '"');
+}
 
-	// Add common BAOS payload data
-	proto_tree_add_item(
-						baos_payload_tree,
-						hf_baos_baos_mainservice,
-						tvb,
-						BAOS_START_INDEX,
-						1,
-						ENC_BIG_ENDIAN
-						);
-	proto_tree_add_item(
-						baos_payload_tree,
-						hf_baos_baos_subservice,
-						tvb,
-						BAOS_START_INDEX + 1,
-						1,
-						ENC_BIG_ENDIAN
-						);
+// Writes the buffered rows
+void
+baos_dp_export_flush(baos_dp_export_t *export_data)
+{
+	fwrite(export_data->buffer->str, 1, export_data->buffer->len, stdout);
+	fflush(stdout);
+	g_string_truncate(export_data->buffer, 0);
+}
 
-	//
-	// From here onwards, the dissection depends on the subservice
-	//
+// Drops the rows not yet written when the capture is dissected again,
+// and starts over with the header row
+void
+baos_dp_export_reset(void *tapdata)
+{
+	baos_dp_export_t *export_data = (baos_dp_export_t *)tapdata;
 
-	// Store BAOS subservice code in var
-	const uint8_t baos_subservice_code = tvb_get_uint8(tvb, BAOS_START_INDEX + 1);
+	g_string_truncate(export_data->buffer, 0);
+	g_string_append(export_data->buffer, BAOS_DP_EXPORT_HEADER);
+}
 
-	// Call dissector function of the corresponding
-	// subservice based on the found subservice code
-	switch (baos_subservice_code)
+// Adds a row for every datapoint value of a telegram.
+// Rows are only written by the draw callback. Once the buffer is full,
+// a redraw is requested, so that periodic redraws write the rows while
+// the capture is read.
+tap_packet_status
+baos_dp_export_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	baos_dp_export_t *export_data = (baos_dp_export_t *)tapdata;
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	if (!baos_info->dp_values)
+		return TAP_PACKET_DONT_REDRAW;
+
+	const baos_dp_value_t *dp_values = (const baos_dp_value_t *)wmem_array_get_raw(baos_info->dp_values);
+	const unsigned nr_of_dp_values = wmem_array_get_count(baos_info->dp_values);
+	const bool is_set_request = baos_info->subservice == SET_DATAPOINT_VALUE_REQ_CODE;
+
+	for (unsigned i = 0; i < nr_of_dp_values; i++)
 	{
-		case GET_SERVER_ITEM_REQ_CODE:
-			dissect_get_server_item_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_SERVER_ITEM_REQ_CODE:
-			dissect_long_server_item_telegram(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DATAPOINT_DESC_REQ_CODE:
-			dissect_get_datapoint_desc_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DESC_STRING_REQ_CODE:
-			dissect_get_desc_string_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DATAPOINT_VALUE_REQ_CODE:
-			dissect_get_datapoint_value_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_DATAPOINT_VALUE_REQ_CODE:
-			dissect_set_datapoint_value_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_PARAMETER_BYTE_REQ_CODE:
-			dissect_get_parameter_byte_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_PARAMETER_BYTE_REQ_CODE:
-			dissect_set_parameter_byte_req(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_SERVER_ITEM_RES_CODE:
-			dissect_long_server_item_telegram(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_SERVER_ITEM_RES_CODE:
-			dissect_set_server_item_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DATAPOINT_DESC_RES_CODE:
-			dissect_get_datapoint_desc_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DESC_STRING_RES_CODE:
-			dissect_get_desc_string_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_DATAPOINT_VALUE_RES_CODE:
-			dissect_get_datapoint_value_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_DATAPOINT_VALUE_RES_CODE:
-			dissect_set_datapoint_value_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case GET_PARAMETER_BYTE_RES_CODE:
-			dissect_get_parameter_byte_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SET_PARAMETER_BYTE_RES_CODE:
-			dissect_set_parameter_byte_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case DATAPOINT_VALUE_IND_CODE:
-			dissect_get_datapoint_value_res(tvb, baos_payload_tree, start_byte_index);
-			break;
-		case SERVER_ITEM_IND_CODE:
-			dissect_long_server_item_telegram(tvb, baos_payload_tree, start_byte_index);
-			break;
-		default:
-			break;
+		const char *dp_name = get_dp_name(pinfo, baos_info->conv_data, dp_values[i].dp_id);
+
+		g_string_append_printf(
+								export_data->buffer,
+								"%" PRId64 ".%09d,%u,%u,%s,%u,",
+								(int64_t)pinfo->abs_ts.secs,
+								pinfo->abs_ts.nsecs,
+								pinfo->num,
+								baos_info->conv_data->index,
+								val_to_str_ext_const(baos_info->subservice, &vs_subservices_ext, "Unknown"),
+								dp_values[i].dp_id
+								);
+		baos_dp_export_append_field(export_data->buffer, dp_name ? dp_name : "");
+		g_string_append_c(export_data->buffer, ',');
+		baos_dp_export_append_field(export_data->buffer, dp_values[i].value);
+		g_string_append_printf(
+								export_data->buffer,
+								is_set_request ? ",,0x%02x\n" : ",0x%02x,\n",
+								dp_values[i].state
+								);
 	}
 
-	//
-	// Dissection of the FT 1.2 trailer
-	//
+	if (export_data->buffer->len >= BAOS_DP_EXPORT_BUFFER_SIZE)
+		return TAP_PACKET_REDRAW;
+	return TAP_PACKET_DONT_REDRAW;
+}
 
-	// Calculate and store index of the start of the FT 1.2 trailer
-	const uint8_t trailer_start_index = start_byte_index + 5 + baos_payload_len;
+// Writes the buffered rows
+void
+baos_dp_export_draw(void *tapdata)
+{
+	baos_dp_export_flush((baos_dp_export_t *)tapdata);
+}
 
-	// Check if FT 1.2 frame is complete and store result in var
-	const bool is_frame_complete = check_packet_integrity(tvb, trailer_start_index);
+// Sets up the datapoint value export for "-z baos,dpvalues[,filter]",
+// which writes one CSV row per datapoint value to the standard output
+void
+baos_dp_export_init(const char *opt_arg, void *userdata _U_)
+{
+	static const char cli_prefix[] = "baos,dpvalues,";
+	baos_dp_export_t *export_data = g_new0(baos_dp_export_t, 1);
 
-	// Add ExpertInfo if FT 1.2 endbyte not found,
-	// meaning frame is likely incomplete
-	if (!is_frame_complete)
+	export_data->buffer = g_string_sized_new(BAOS_DP_EXPORT_BUFFER_SIZE + 1024);
+	if (strncmp(opt_arg, cli_prefix, strlen(cli_prefix)) == 0)
+		export_data->filter = g_strdup(opt_arg + strlen(cli_prefix));
+
+	GString *error_string = register_tap_listener(
+													"baos",
+													export_data,
+													export_data->filter,
+													TL_REQUIRES_NOTHING,
+													baos_dp_export_reset,
+													baos_dp_export_packet,
+													baos_dp_export_draw,
+													NULL
+													);
+	if (error_string)
 	{
-		expert_add_info(pinfo, ft12_ti, &ei_ft12_incomplete_frame);
+		report_failure("Couldn't register BAOS datapoint value export: %s", error_string->str);
+		g_string_free(error_string, TRUE);
+		g_string_free(export_data->buffer, TRUE);
+		g_free(export_data->filter);
+		g_free(export_data);
+		return;
 	}
 
-	// Build FT 1.2 trailer subtree if at least
-	// first byte of the trailer is in TVB
-	if (tvb->length >= (uint16_t)(trailer_start_index + 1))
+	g_string_append(export_data->buffer, BAOS_DP_EXPORT_HEADER);
+}
+
+static stat_tap_ui baos_dp_export_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	"BAOS Datapoint Value Export",
+	"baos,dpvalues",
+	baos_dp_export_init,
+	0,
+	NULL
+};
+
+//
+// Parameter byte report
+//
+
+// Clears the parameter byte images before the capture is retapped
+void
+baos_param_report_reset(void *tapdata)
+{
+	baos_param_report_t *report = (baos_param_report_t *)tapdata;
+
+	wmem_free_all(report->scope);
+	report->devices = wmem_tree_new(report->scope);
+}
+
+// Adds the parameter bytes of a telegram to the image of its device
+tap_packet_status
+baos_param_report_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt _U_, const void *p, tap_flags_t flags _U_)
+{
+	baos_param_report_t *report = (baos_param_report_t *)tapdata;
+	const baos_info_t *baos_info = (const baos_info_t *)p;
+
+	if (!baos_info->param_bytes)
+		return TAP_PACKET_DONT_REDRAW;
+
+	baos_param_report_device_t *device = (baos_param_report_device_t *)wmem_tree_lookup32(report->devices, baos_info->conv_data->index);
+	if (!device)
 	{
-		// FT 1.2 trailer subtree
-		proto_item *ft12_trailer_ti = proto_tree_add_item(
-														ft12_tree,
-														hf_baos_ft12_trailer,
-														tvb,
-														trailer_start_index,
-														2,
-														ENC_NA
-														);
-		proto_tree *ft12_trailer_tree = proto_item_add_subtree(ft12_trailer_ti, ett_ft12_trailer);
+		device = wmem_new0(report->scope, baos_param_report_device_t);
+		device->name = wmem_strdup(report->scope, baos_info->conv_data->name);
+		device->param_image = wmem_tree_new(report->scope);
+		wmem_tree_insert32(report->devices, baos_info->conv_data->index, device);
+	}
 
-		// Define var for checksum found in telegram
-		uint32_t ft12_checksum = 0;
-		// Store calculated checksum of the packet
-		const uint32_t calculated_checksum = calculateChecksum(tvb, start_byte_index, trailer_start_index);
+	update_param_image(device->param_image, report->scope, baos_info, pinfo->num, NULL);
 
-		// Add FT 1.2 checksum to tree structure
-		// and store the value in "ft12_checksum"
-		proto_tree_add_item_ret_uint(
-							ft12_trailer_tree,
-							hf_baos_ft12_checksum,
-							tvb,
-							trailer_start_index,
-							1,
-							ENC_BIG_ENDIAN,
-							&ft12_checksum
-							);
+	return TAP_PACKET_REDRAW;
+}
 
-		// Add ExpertInfo if found checksum doesn't match
-		// calculated expected checksum
-		if (ft12_checksum != calculated_checksum)
+// Prints a parameter byte of the image
+bool
+baos_param_report_draw_byte(const void *key _U_, void *value, void *userdata _U_)
+{
+	const baos_param_byte_t *param_byte = (const baos_param_byte_t *)value;
+
+	if (param_byte->last_write_frame)
+		printf("  %5u   0x%02x  %10u  %12u\n", param_byte->id, param_byte->value, param_byte->last_frame, param_byte->last_write_frame);
+	else
+		printf("  %5u   0x%02x  %10u  %12s\n", param_byte->id, param_byte->value, param_byte->last_frame, "-");
+
+	return false;
+}
+
+// Prints the parameter byte image of a device
+bool
+baos_param_report_draw_device(const void *key _U_, void *value, void *userdata _U_)
+{
+	const baos_param_report_device_t *device = (const baos_param_report_device_t *)value;
+
+	printf("\n%s\n", device->name);
+	printf("   Byte  Value   Last seen  Last written\n");
+	wmem_tree_foreach(device->param_image, baos_param_report_draw_byte, NULL);
+
+	return false;
+}
+
+// Prints the parameter byte images of all devices
+void
+baos_param_report_draw(void *tapdata)
+{
+	const baos_param_report_t *report = (const baos_param_report_t *)tapdata;
+
+	printf("\n");
+	printf("==========================================\n");
+	printf("BAOS Parameter Byte Image\n");
+	printf("Filter: %s\n", report->filter ? report->filter : "none");
+	wmem_tree_foreach(report->devices, baos_param_report_draw_device, NULL);
+	printf("==========================================\n");
+}
+
+// Sets up the parameter byte report for "-z baos,params[,filter]".
+// A filter like "frame.number<=1000" shows the image at that frame.
+void
+baos_param_report_init(const char *opt_arg, void *userdata _U_)
+{
+	static const char cli_prefix[] = "baos,params,";
+	baos_param_report_t *report = g_new0(baos_param_report_t, 1);
+
+	report->scope = wmem_allocator_new(WMEM_ALLOCATOR_SIMPLE);
+	report->devices = wmem_tree_new(report->scope);
+	if (strncmp(opt_arg, cli_prefix, strlen(cli_prefix)) == 0)
+		report->filter = g_strdup(opt_arg + strlen(cli_prefix));
+
+	GString *error_string = register_tap_listener(
+													"baos",
+													report,
+													report->filter,
+													TL_REQUIRES_NOTHING,
+													baos_param_report_reset,
+													baos_param_report_packet,
+													baos_param_report_draw,
+													NULL
+													);
+	if (error_string)
+	{
+		report_failure("Couldn't register BAOS parameter byte report: %s", error_string->str);
+		g_string_free(error_string, TRUE);
+		wmem_destroy_allocator(report->scope);
+		g_free(report->filter);
+		g_free(report);
+	}
+}
+
+static stat_tap_ui baos_param_report_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	"BAOS Parameter Byte Image",
+	"baos,params",
+	baos_param_report_init,
+	0,
+	NULL
+};
+
+// Checks that a value string lists the values of the given runs
+// of its enum in ascending order, with a label for each of them
+// and nothing else. Reports a failure for the first problem found.
+// Returns true if the value string is complete and sorted.
+bool
+check_value_string(const char *name, const value_string *vs, const enum_range_t *ranges, size_t nr_of_ranges)
+{
+	uint32_t nr_of_values = 0;
+	for (; vs[nr_of_values].strptr; nr_of_values++)
+	{
+		if (nr_of_values && vs[nr_of_values - 1].value >= vs[nr_of_values].value)
 		{
-			expert_add_info_format(pinfo, ft12_ti, &ei_ft12_checksum_error, "Expected checksum: 0x%x Found checksum: 0x%x", calculated_checksum, ft12_checksum);
+			report_failure("BAOS value string %s is not sorted: %u follows %u",
+							name, vs[nr_of_values].value, vs[nr_of_values - 1].value);
+			return false;
 		}
-		if (tvb->length >= trailer_start_index + 2u)
+	}
+
+	uint32_t nr_of_enum_values = 0;
+	for (size_t i = 0; i < nr_of_ranges; i++)
+	{
+		for (uint32_t value = ranges[i].first; value <= ranges[i].last; value++)
 		{
-			// Add FT 1.2 endbyte
-			proto_tree_add_item(
-								ft12_trailer_tree,
-								hf_baos_ft12_endbyte,
-								tvb,
-								trailer_start_index + 1,
-								1,
-								ENC_BIG_ENDIAN
-								);
+			if (!try_val_to_str(value, vs))
+			{
+				report_failure("BAOS value string %s has no label for %u", name, value);
+				return false;
+			}
+			nr_of_enum_values++;
 		}
 	}
 
+	if (nr_of_values != nr_of_enum_values)
+	{
+		report_failure("BAOS value string %s has %u labels for %u values",
+						name, nr_of_values, nr_of_enum_values);
+		return false;
+	}
 	return true;
 }
 
@@ -1446,6 +4632,11 @@ dissect_baos_heur(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *dat
 void
 proto_register_baos(void)
 {
+	// The extended value strings rely on sorted and complete tables
+	check_value_string("vs_subservices", vs_subservices, subservice_ranges, array_length(subservice_ranges));
+	check_value_string("vs_baos_dpts", vs_baos_dpts, dpt_ranges, array_length(dpt_ranges));
+	check_value_string("vs_server_items", vs_server_items, server_item_ranges, array_length(server_item_ranges));
+
 	// HeaderField definitions
 	static hf_register_info hf[] = {
 		{
@@ -1473,38 +4664,134 @@ proto_register_baos(void)
 			{"FT 1.2 length byte",
 					"baos.ft12.lengthbyte",
 					FT_UINT8, BASE_DEC,
-					NULL, 0x0,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_controllbyte,
+			{"FT 1.2 controll byte",
+					"baos.ft12.controllbyte",
+					FT_UINT8, BASE_HEX,
+					VALS(vs_ft12_control_bytes), 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_trailer,
+			{"FT 1.2 trailer",
+					"baos.ft12.ft12_trailer",
+					FT_PROTOCOL},
+		},
+		{
+			&hf_baos_ft12_checksum,
+			{"FT 1.2 checksum",
+					"baos.ft12.checksum",
+					FT_UINT8, BASE_HEX,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_endbyte,
+			{"FT 1.2 endbyte",
+					"baos.ft12.endbyte",
+					FT_UINT8, BASE_HEX,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_skipped,
+			{"Bytes skipped before the FT 1.2 frame",
+					"baos.ft12.skipped",
+					FT_BYTES, BASE_NONE,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_ack,
+			{"FT 1.2 acknowledgement",
+					"baos.ft12.ack",
+					FT_UINT8, BASE_HEX,
+					NULL, 0x0,
+					"Single character acknowledgement", HFILL}
+		},
+		{
+			&hf_baos_ft12_fixed_controlbyte,
+			{"FT 1.2 control byte",
+					"baos.ft12.fixed_controlbyte",
+					FT_UINT8, BASE_HEX,
+					NULL, 0x0,
+					"Control byte of a fixed length frame", HFILL}
+		},
+		{
+			&hf_baos_ft12_control_dir,
+			{"Direction",
+					"baos.ft12.control.dir",
+					FT_BOOLEAN, 8,
+					TFS(&tfs_ft12_control_dir), FT12_CONTROL_DIR,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_control_prm,
+			{"Primary message",
+					"baos.ft12.control.prm",
+					FT_BOOLEAN, 8,
+					TFS(&tfs_ft12_control_prm), FT12_CONTROL_PRM,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_control_fcb,
+			{"Frame count bit",
+					"baos.ft12.control.fcb",
+					FT_BOOLEAN, 8,
+					NULL, 0x20,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_control_fcv,
+			{"Frame count bit valid",
+					"baos.ft12.control.fcv",
+					FT_BOOLEAN, 8,
+					NULL, 0x10,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_ft12_control_prm_function,
+			{"Function",
+					"baos.ft12.control.prm_function",
+					FT_UINT8, BASE_DEC,
+					VALS(vs_ft12_prm_functions), FT12_CONTROL_FUNCTION,
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_ft12_controllbyte,
-			{"FT 1.2 controll byte",
-					"baos.ft12.controllbyte",
-					FT_UINT8, BASE_HEX,
-					VALS(vs_ft12_control_bytes), 0x0,
+			&hf_baos_ft12_control_sec_function,
+			{"Function",
+					"baos.ft12.control.sec_function",
+					FT_UINT8, BASE_DEC,
+					VALS(vs_ft12_sec_functions), FT12_CONTROL_FUNCTION,
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_ft12_trailer,
-			{"FT 1.2 trailer",
-					"baos.ft12.ft12_trailer",
-					FT_PROTOCOL},
+			&hf_baos_ft12_ack_to,
+			{"Acknowledgement to",
+					"baos.ft12.ack_to",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_ACK), 0x0,
+					"This is an acknowledgement of the FT 1.2 frame in this frame", HFILL}
 		},
 		{
-			&hf_baos_ft12_checksum,
-			{"FT 1.2 checksum",
-					"baos.ft12.checksum",
-					FT_UINT8, BASE_HEX,
+			&hf_baos_ft12_ack_in,
+			{"Acknowledged in",
+					"baos.ft12.ack_in",
+					FT_FRAMENUM, BASE_NONE,
 					NULL, 0x0,
-					NULL, HFILL}
+					"The acknowledgement of this FT 1.2 frame is in this frame", HFILL}
 		},
 		{
-			&hf_baos_ft12_endbyte,
-			{"FT 1.2 endbyte",
-					"baos.ft12.endbyte",
-					FT_UINT8, BASE_HEX,
+			&hf_baos_ft12_ack_latency,
+			{"Acknowledgement latency",
+					"baos.ft12.ack_latency",
+					FT_RELATIVE_TIME, BASE_NONE,
 					NULL, 0x0,
-					NULL, HFILL}
+					"Time between an FT 1.2 frame and its acknowledgement", HFILL}
 		},
 		{
 			&hf_baos_baos_payload,
@@ -1524,8 +4811,8 @@ proto_register_baos(void)
 			&hf_baos_baos_subservice,
 			{"BAOS subservice",
 					"baos.subservice",
-					FT_UINT8, BASE_HEX,
-					VALS(vs_subservices), 0x0,
+					FT_UINT8, BASE_HEX | BASE_EXT_STRING,
+					&vs_subservices_ext, 0x0,
 					NULL, HFILL}
 		},
 		{
@@ -1540,8 +4827,8 @@ proto_register_baos(void)
 			&hf_baos_start_server_item_id,
 			{"Start server item ID",
 					"baos.start_server_item_id",
-					FT_UINT16, BASE_DEC,
-					VALS(vs_server_items), 0x0,
+					FT_UINT16, BASE_DEC | BASE_EXT_STRING,
+					&vs_server_items_ext, 0x0,
 					NULL, HFILL}
 		},
 		{
@@ -1556,8 +4843,8 @@ proto_register_baos(void)
 			&hf_baos_server_item_id,
 			{"Server item ID",
 					"baos.server_item_id",
-					FT_UINT16, BASE_DEC,
-					VALS(vs_server_items), 0x0,
+					FT_UINT16, BASE_DEC | BASE_EXT_STRING,
+					&vs_server_items_ext, 0x0,
 					NULL, HFILL}
 		},
 		{
@@ -1585,9 +4872,49 @@ proto_register_baos(void)
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_si_version,
-			{"Version number",
-					"baos.server_item.version",
+			&hf_baos_si_hardware_version,
+			{"Hardware version",
+					"baos.server_item.hardware_version",
+					FT_UINT8, BASE_HEX,
+					NULL, 0xFF,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_firmware_version,
+			{"Firmware version",
+					"baos.server_item.firmware_version",
+					FT_UINT8, BASE_HEX,
+					NULL, 0xFF,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_app_version,
+			{"Application version (ETS)",
+					"baos.server_item.app_version",
+					FT_UINT8, BASE_HEX,
+					NULL, 0xFF,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_proto_version_bin,
+			{"Protocol version (Binary)",
+					"baos.server_item.proto_version_bin",
+					FT_UINT8, BASE_HEX,
+					NULL, 0xFF,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_proto_version_web,
+			{"Protocol version (WebService)",
+					"baos.server_item.proto_version_web",
+					FT_UINT8, BASE_HEX,
+					NULL, 0xFF,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_proto_version_rest,
+			{"Protocol version (RestService)",
+					"baos.server_item.proto_version_rest",
 					FT_UINT8, BASE_HEX,
 					NULL, 0xFF,
 					NULL, HFILL}
@@ -1609,9 +4936,17 @@ proto_register_baos(void)
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_si_knx_man_code,
-			{"KNX manufacturer code",
-					"baos.server_item.knx_man_code",
+			&hf_baos_si_knx_man_code_dev,
+			{"KNX manufacturer code (device)",
+					"baos.server_item.knx_man_code_dev",
+					FT_UINT16, BASE_HEX,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_knx_man_code_app,
+			{"KNX manufacturer code (application)",
+					"baos.server_item.knx_man_code_app",
 					FT_UINT16, BASE_HEX,
 					NULL, 0x0,
 					NULL, HFILL}
@@ -1635,23 +4970,47 @@ proto_register_baos(void)
 		{
 			&hf_baos_si_time_since_reset,
 			{"Time since reset [ms]",
-					"baos.server_item.app_id",
+					"baos.server_item.time_since_reset",
 					FT_UINT32, BASE_DEC,
 					NULL, 0x0,
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_si_server_item_status,
-			{"Status",
-					"baos.server_item.server_item_status",
-					FT_BOOLEAN, BASE_HEX,
-					TFS(&vs_server_item_status), 0x0,
+			&hf_baos_si_bus_connected,
+			{"Bus connection state",
+					"baos.server_item.bus_connected",
+					FT_BOOLEAN, BASE_NONE,
+					TFS(&vs_si_bus_connection_state), 0x0,
 					NULL, HFILL}
 		},
 		{
-			&hf_baos_si_buffer_size,
-			{"Buffer size [bytes]",
-					"baos.server_item.buffer_size",
+			&hf_baos_si_programming_mode,
+			{"Programming mode",
+					"baos.server_item.programming_mode",
+					FT_BOOLEAN, BASE_NONE,
+					TFS(&vs_si_programming_mode), 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_indication_sending,
+			{"Indication sending",
+					"baos.server_item.indication_sending",
+					FT_BOOLEAN, BASE_NONE,
+					TFS(&vs_si_indication_sending), 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_max_buffer_size,
+			{"Maximum buffer size [bytes]",
+					"baos.server_item.max_buffer_size",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					NULL, HFILL}
+		},
+		{
+			&hf_baos_si_current_buffer_size,
+			{"Current buffer size [bytes]",
+					"baos.server_item.current_buffer_size",
 					FT_UINT16, BASE_DEC,
 					NULL, 0x0,
 					NULL, HFILL}
@@ -1664,6 +5023,38 @@ proto_register_baos(void)
 					NULL, 0x0,
 					NULL, HFILL}
 		},
+		{
+			&hf_baos_si_version,
+			{"Version number",
+					"baos.server_item.version",
+					FT_UINT8, BASE_HEX,
+					NULL, 0x0,
+					"Any of the version server items, kept for existing filters", HFILL}
+		},
+		{
+			&hf_baos_si_knx_man_code,
+			{"KNX manufacturer code",
+					"baos.server_item.knx_man_code",
+					FT_UINT16, BASE_HEX,
+					NULL, 0x0,
+					"Any of the KNX manufacturer code server items, kept for existing filters", HFILL}
+		},
+		{
+			&hf_baos_si_server_item_status,
+			{"Status",
+					"baos.server_item.server_item_status",
+					FT_BOOLEAN, BASE_NONE,
+					NULL, 0x0,
+					"Bus connection state, programming mode or indication sending, kept for existing filters", HFILL}
+		},
+		{
+			&hf_baos_si_buffer_size,
+			{"Buffer size [bytes]",
+					"baos.server_item.buffer_size",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					"Maximum or current buffer size, kept for existing filters", HFILL}
+		},
 		{
 			&hf_baos_si_baudrate,
 			{"Baudrate",
@@ -1791,6 +5182,70 @@ proto_register_baos(void)
 					NULL, 0x0,
 					NULL, HFILL}
 		},
+		{
+			&hf_baos_dp_value_bool,
+			{"Boolean value",
+					"baos.dp_value.bool",
+					FT_BOOLEAN, BASE_NONE,
+					NULL, 0x0,
+					"Datapoint value decoded according to its DPT", HFILL}
+		},
+		{
+			&hf_baos_dp_value_unsigned,
+			{"Unsigned value",
+					"baos.dp_value.unsigned",
+					FT_UINT32, BASE_DEC,
+					NULL, 0x0,
+					"Datapoint value decoded according to the DPT from the catalog", HFILL}
+		},
+		{
+			&hf_baos_dp_value_signed,
+			{"Signed value",
+					"baos.dp_value.signed",
+					FT_INT32, BASE_DEC,
+					NULL, 0x0,
+					"Datapoint value decoded according to the DPT from the catalog", HFILL}
+		},
+		{
+			&hf_baos_dp_value_float,
+			{"Float value",
+					"baos.dp_value.float",
+					FT_DOUBLE, BASE_NONE,
+					NULL, 0x0,
+					"Datapoint value decoded according to the DPT from the catalog", HFILL}
+		},
+		{
+			&hf_baos_dp_value_text,
+			{"Decoded value",
+					"baos.dp_value.text",
+					FT_STRING, BASE_NONE,
+					NULL, 0x0,
+					"Datapoint value decoded according to the DPT from the catalog", HFILL}
+		},
+		{
+			&hf_baos_dp_catalog_dpt,
+			{"Catalog DPT",
+					"baos.dp_catalog.dpt",
+					FT_UINT8, BASE_HEX | BASE_EXT_STRING,
+					&vs_baos_dpts_ext, 0x0,
+					"Datapoint type listed in the datapoint catalog", HFILL}
+		},
+		{
+			&hf_baos_dp_device_dpt,
+			{"Reported DPT",
+					"baos.dp_device.dpt",
+					FT_UINT8, BASE_HEX | BASE_EXT_STRING,
+					&vs_baos_dpts_ext, 0x0,
+					"Datapoint type the device reported in GetDatapointDescription.Res, used if the catalog doesn't list one", HFILL}
+		},
+		{
+			&hf_baos_dp_catalog_value_type,
+			{"Catalog value type",
+					"baos.dp_catalog.value_type",
+					FT_UINT8, BASE_HEX,
+					VALS(vs_baos_dp_value_types), 0x0,
+					"Datapoint value type listed in the datapoint catalog", HFILL}
+		},
 		{
 			&hf_baos_dp_filter,
 			{"Datapoint filter",
@@ -1875,8 +5330,8 @@ proto_register_baos(void)
 			&hf_baos_dp_dpt,
 			{"Datapoint DPT",
 					"baos.dp_dpt",
-					FT_UINT8, BASE_HEX,
-					VALS(vs_baos_dpts), 0x0,
+					FT_UINT8, BASE_HEX | BASE_EXT_STRING,
+					&vs_baos_dpts_ext, 0x0,
 					NULL, HFILL}
 		},
 		{
@@ -1903,6 +5358,14 @@ proto_register_baos(void)
 					NULL, 0x0,
 					NULL, HFILL}
 		},
+		{
+			&hf_baos_param_byte_prev_write,
+			{"Previously written in",
+					"baos.param_byte.prev_write",
+					FT_FRAMENUM, BASE_NONE,
+					NULL, 0x0,
+					"The parameter byte was last written in this frame", HFILL}
+		},
 		{
 			&hf_baos_start_desc_string,
 			{"ID of start description string",
@@ -1934,6 +5397,174 @@ proto_register_baos(void)
 					FT_STRING, BASE_STR_WSP,
 					NULL, 0x0,
 					NULL, HFILL}
+		},
+		{
+			&hf_baos_buffer_size,
+			{"Buffer size [bytes]",
+					"baos.buffer_size",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					"Buffer size reported by the device in effect for this telegram", HFILL}
+		},
+		{
+			&hf_baos_request_in,
+			{"Request in",
+					"baos.request_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_REQUEST), 0x0,
+					"The request to this BAOS response is in this frame", HFILL}
+		},
+		{
+			&hf_baos_response_in,
+			{"Response in",
+					"baos.response_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_RESPONSE), 0x0,
+					"The response to this BAOS request is in this frame", HFILL}
+		},
+		{
+			&hf_baos_response_time,
+			{"Response time",
+					"baos.response_time",
+					FT_RELATIVE_TIME, BASE_NONE,
+					NULL, 0x0,
+					"Time between request and response", HFILL}
+		},
+		{
+			&hf_baos_poll_changed_dps,
+			{"Changed datapoints",
+					"baos.poll.changed_dps",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					"Returned datapoints whose value has changed since it was last reported", HFILL}
+		},
+		{
+			&hf_baos_poll_unchanged_dps,
+			{"Unchanged datapoints",
+					"baos.poll.unchanged_dps",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					"Returned datapoints whose value has not changed since it was last reported", HFILL}
+		},
+		{
+			&hf_baos_poll_wasted_bytes,
+			{"Wasted bytes",
+					"baos.poll.wasted_bytes",
+					FT_UINT32, BASE_DEC,
+					NULL, 0x0,
+					"Bytes spent on reporting unchanged datapoints", HFILL}
+		},
+		{
+			&hf_baos_dp_trans_start_in,
+			{"Transmission started in",
+					"baos.dp_trans.start_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_REQUEST), 0x0,
+					"Frame in which the datapoint was first seen requested or in progress", HFILL}
+		},
+		{
+			&hf_baos_dp_trans_time,
+			{"Transmission time",
+					"baos.dp_trans.time",
+					FT_RELATIVE_TIME, BASE_NONE,
+					NULL, 0x0,
+					"Time since the transmission of the datapoint was first seen", HFILL}
+		},
+		{
+			&hf_baos_dp_write_req_in,
+			{"Write requested in",
+					"baos.dp_write.req_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_REQUEST), 0x0,
+					"SetDatapointValue.Req of the write", HFILL}
+		},
+		{
+			&hf_baos_dp_write_res_in,
+			{"Write answered in",
+					"baos.dp_write.res_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_RESPONSE), 0x0,
+					"SetDatapointValue.Res of the write", HFILL}
+		},
+		{
+			&hf_baos_dp_write_ind_in,
+			{"Write confirmed in",
+					"baos.dp_write.ind_in",
+					FT_FRAMENUM, BASE_NONE,
+					FRAMENUM_TYPE(FT_FRAMENUM_ACK), 0x0,
+					"DatapointValue.Ind confirming the write", HFILL}
+		},
+		{
+			&hf_baos_dp_write_res_time,
+			{"Request to response",
+					"baos.dp_write.res_time",
+					FT_RELATIVE_TIME, BASE_NONE,
+					NULL, 0x0,
+					"Time spent by the host, the serial link and the object server", HFILL}
+		},
+		{
+			&hf_baos_dp_write_ind_time,
+			{"Response to indication",
+					"baos.dp_write.ind_time",
+					FT_RELATIVE_TIME, BASE_NONE,
+					NULL, 0x0,
+					"Time spent on the KNX bus", HFILL}
+		},
+		{
+			&hf_baos_dp_write_latency,
+			{"Write latency",
+					"baos.dp_write.latency",
+					FT_RELATIVE_TIME, BASE_NONE,
+					NULL, 0x0,
+					"Time from request to confirming indication", HFILL}
+		},
+		{
+			&hf_baos_bus_load_rate,
+			{"Bus load [1/s]",
+					"baos.bus_load.rate",
+					FT_DOUBLE, BASE_NONE,
+					NULL, 0x0,
+					"Datapoint updates from the bus per second in the sliding window", HFILL}
+		},
+		{
+			&hf_baos_bus_load_distinct_dps,
+			{"Distinct datapoints",
+					"baos.bus_load.distinct_dps",
+					FT_UINT32, BASE_DEC,
+					NULL, 0x0,
+					"Distinct datapoints updated from the bus in the sliding window", HFILL}
+		},
+		{
+			&hf_baos_bus_load_peak_rate,
+			{"Peak bus load [1/s]",
+					"baos.bus_load.peak_rate",
+					FT_DOUBLE, BASE_NONE,
+					NULL, 0x0,
+					"Highest bus load of the device so far", HFILL}
+		},
+		{
+			&hf_baos_bus_load_peak_in,
+			{"Peak bus load in",
+					"baos.bus_load.peak_in",
+					FT_FRAMENUM, BASE_NONE,
+					NULL, 0x0,
+					"DatapointValue.Ind at which the peak bus load was seen", HFILL}
+		},
+		{
+			&hf_baos_heur_result,
+			{"Heuristic result",
+					"baos.heur.result",
+					FT_UINT8, BASE_DEC,
+					VALS(vs_baos_heur_results), 0x0,
+					"How the heuristic took the USB transfer", HFILL}
+		},
+		{
+			&hf_baos_buffer_utilization,
+			{"Buffer utilization [%]",
+					"baos.buffer_utilization",
+					FT_UINT16, BASE_DEC,
+					NULL, 0x0,
+					"BAOS payload length relative to the buffer size", HFILL}
 		}
 	};
 
@@ -1944,10 +5575,65 @@ proto_register_baos(void)
 			{ "baos.ft12_incomplete", PI_MALFORMED, PI_WARN,
 			  "FT 1.2 likely incomplete", EXPFILL }
 		},
+		{
+			&ei_baos_truncated,
+			{ "baos.truncated", PI_MALFORMED, PI_WARN,
+			  "Telegram truncated", EXPFILL }
+		},
+		{
+			&ei_ft12_resync,
+			{ "baos.ft12_resync", PI_SEQUENCE, PI_NOTE,
+			  "Resynchronized to an FT 1.2 frame", EXPFILL }
+		},
 		{
 			&ei_ft12_checksum_error,
 			{ "baos.checksum_error", PI_CHECKSUM, PI_ERROR,
 			  "FT 1.2 checksum error", EXPFILL }
+		},
+		{
+			&ei_baos_buffer_nearly_full,
+			{ "baos.buffer_nearly_full", PI_PROTOCOL, PI_WARN,
+			  "BAOS payload close to the buffer size", EXPFILL }
+		},
+		{
+			&ei_baos_buffer_exceeded,
+			{ "baos.buffer_exceeded", PI_PROTOCOL, PI_ERROR,
+			  "BAOS payload exceeds the buffer size", EXPFILL }
+		},
+		{
+			&ei_baos_poll_overlap,
+			{ "baos.poll.overlap", PI_SEQUENCE, PI_NOTE,
+			  "Datapoint range overlaps the range of the previous poll", EXPFILL }
+		},
+		{
+			&ei_baos_poll_repeated,
+			{ "baos.poll.repeated", PI_SEQUENCE, PI_NOTE,
+			  "Poll repeated, although the previous identical poll returned no changes", EXPFILL }
+		},
+		{
+			&ei_baos_poll_no_changes,
+			{ "baos.poll.no_changes", PI_SEQUENCE, PI_NOTE,
+			  "Poll returned no changed datapoints", EXPFILL }
+		},
+		{
+			&ei_baos_dp_trans_stuck,
+			{ "baos.dp_trans.stuck", PI_SEQUENCE, PI_WARN,
+			  "Datapoint transmission pending for too long", EXPFILL }
+		},
+		{
+			&ei_baos_dp_trans_failed,
+			{ "baos.dp_trans.failed", PI_RESPONSE_CODE, PI_WARN,
+			  "Datapoint transmission ended with an error", EXPFILL }
+		},
+		{
+			&ei_baos_bus_storm,
+			{ "baos.bus_load.storm", PI_SEQUENCE, PI_WARN,
+			  "Bus storm", EXPFILL }
+		},
+		{
+			&ei_baos_state_budget,
+			{ "baos.state_budget", PI_UNDECODED, PI_NOTE,
+			  "State budget of the device used up, telegram not analyzed", EXPFILL }
 		}
 	};
 
@@ -1957,7 +5643,15 @@ proto_register_baos(void)
 		&ett_ft12,
 		&ett_ft12_header,
 		&ett_ft12_trailer,
-		&ett_baos_payload
+		&ett_ft12_control,
+		&ett_baos_payload,
+		&ett_baos_server_item,
+		&ett_baos_si_version,
+		&ett_baos_si_knx_address,
+		&ett_baos_dp,
+		&ett_baos_dp_state,
+		&ett_baos_dp_config,
+		&ett_baos_desc_string
 	};
 
 	// Register protocol
@@ -1967,6 +5661,21 @@ proto_register_baos(void)
 										"baos" /* filter name */
 										);
 
+	// Register tap for statistics
+	baos_tap = register_tap("baos");
+	baos_heur_tap = register_tap("baos_heur");
+	baos_ack_tap = register_tap("baos_ack");
+
+	// Register dissector for FT 1.2 frames not carried by USB,
+	// e.g. in exported PDUs written by the baosserialdump extcap
+	register_dissector("baos_ft12", dissect_baos_ft12, proto_baos);
+
+	// Setup map holding the state of the BAOS devices,
+	// which is emptied when a capture file is closed
+	baos_conv_data_map = wmem_map_new_autoreset(wmem_epan_scope(), wmem_file_scope(), g_direct_hash, g_direct_equal);
+	baos_dp_name_pool = wmem_map_new_autoreset(wmem_epan_scope(), wmem_file_scope(), g_str_hash, g_str_equal);
+	register_init_routine(baos_init);
+
 	// Register that the protocol has expert infos
 	expert_module_t *expert_baos = expert_register_protocol(proto_baos);
 
@@ -1974,6 +5683,76 @@ proto_register_baos(void)
 	proto_register_field_array(proto_baos, hf, array_length(hf));
 	proto_register_subtree_array(ett, array_length(ett));
 	expert_register_field_array(expert_baos, ei, array_length(ei));
+
+	// Register preferences
+	module_t *baos_module = prefs_register_protocol(proto_baos, apply_baos_prefs);
+	prefs_register_uint_preference(
+									baos_module,
+									"buffer_warning_threshold",
+									"Buffer utilization warning threshold [%]",
+									"Warn about telegrams whose BAOS payload uses at least "
+									"this share of the buffer size reported by the device",
+									10,
+									&pref_buffer_warning_threshold
+									);
+	prefs_register_uint_preference(
+									baos_module,
+									"trans_stuck_threshold",
+									"Stuck transmission threshold [ms]",
+									"Warn about datapoints whose transmission to the bus "
+									"is still pending after this time",
+									10,
+									&pref_trans_stuck_threshold
+									);
+	prefs_register_uint_preference(
+									baos_module,
+									"bus_load_window",
+									"Bus load window [ms]",
+									"Length of the sliding window over which datapoint "
+									"updates from the bus are counted",
+									10,
+									&pref_bus_load_window
+									);
+	prefs_register_uint_preference(
+									baos_module,
+									"bus_storm_threshold",
+									"Bus storm threshold [1/s]",
+									"Warn about DatapointValue.Ind telegrams seen at a bus load "
+									"of at least this many datapoint updates per second (0 to disable)",
+									10,
+									&pref_bus_storm_threshold
+									);
+	prefs_register_uint_preference(
+									baos_module,
+									"state_budget",
+									"State budget per device [KiB]",
+									"Memory the state kept for a device may use. Once it's used up, "
+									"telegrams are only linked with their requests, responses and "
+									"acknowledgements, without further analysis, and a newly reported "
+									"datapoint replaces the one updated least recently that has no "
+									"pending transmission (0 for no limit)",
+									10,
+									&pref_state_budget
+									);
+	prefs_register_obsolete_preference(baos_module, "dp_history_budget");
+	prefs_register_bool_preference(
+									baos_module,
+									"heur_result_field",
+									"Show the heuristic result",
+									"Add the outcome of the heuristic, including checksum "
+									"and end byte errors, to every BAOS telegram",
+									&pref_heur_result_field
+									);
+	prefs_register_filename_preference(
+										baos_module,
+										"dp_catalog_file",
+										"Datapoint catalog file",
+										"CSV file listing datapoints as <DP ID>,<name>,<DPT>,<value type>. "
+										"Used to name datapoints and decode their values without "
+										"GetDescriptionString or GetDatapointDescription telegrams",
+										&pref_dp_catalog_file,
+										false
+										);
 }
 
 // Register dissector as a heuristic dissector
@@ -1988,4 +5767,97 @@ proto_reg_handoff_baos(void)
 						proto_baos,
 						HEURISTIC_ENABLE
 						);
+
+	// Register statistics trees
+	stats_tree_register(
+						"baos",
+						"baos_devices",
+						"BAOS/Device Inventory",
+						0,
+						baos_devices_stats_tree_packet,
+						baos_devices_stats_tree_init,
+						NULL
+						);
+	stats_tree_register(
+						"baos",
+						"baos_buffer",
+						"BAOS/Buffer Utilization",
+						0,
+						baos_buffer_stats_tree_packet,
+						baos_buffer_stats_tree_init,
+						NULL
+						);
+	stats_tree_register(
+						"baos",
+						"baos_polls",
+						"BAOS/Polling Efficiency",
+						0,
+						baos_poll_stats_tree_packet,
+						baos_poll_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos",
+						"baos_transmissions",
+						"BAOS/Transmission Latency",
+						0,
+						baos_trans_stats_tree_packet,
+						baos_trans_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos",
+						"baos_writes",
+						"BAOS/Write Latency",
+						0,
+						baos_write_stats_tree_packet,
+						baos_write_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos",
+						"baos_bus_load",
+						"BAOS/Bus Load",
+						0,
+						baos_bus_load_stats_tree_packet,
+						baos_bus_load_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos_ack",
+						"baos_link_latency",
+						"BAOS/Link Layer Latency",
+						0,
+						baos_ack_stats_tree_packet,
+						baos_ack_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos_heur",
+						"baos_heur",
+						"BAOS/Heuristic",
+						0,
+						baos_heur_stats_tree_packet,
+						baos_heur_stats_tree_init,
+						NULL
+						);
+
+	stats_tree_register(
+						"baos",
+						"baos_memory",
+						"BAOS/Memory Usage",
+						0,
+						baos_mem_stats_tree_packet,
+						baos_mem_stats_tree_init,
+						NULL
+						);
+
+	// Register datapoint value export and parameter byte report
+	register_stat_tap_ui(&baos_dp_export_ui, NULL);
+	register_stat_tap_ui(&baos_param_report_ui, NULL);
 }
\ No newline at end of file
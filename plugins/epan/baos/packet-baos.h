@@ -15,20 +15,33 @@
 #define PACKET_BAOS_H
 
 // Imports
+#include <assert.h>
+
 #include <epan/packet.h>
 #include <epan/dissectors/packet-usb.h>
 #include <epan/tvbuff-int.h>
 #include <epan/expert.h>
+#include <epan/tap.h>
+#include <epan/stats_tree.h>
+#include <epan/prefs.h>
+#include <epan/stat_tap_ui.h>
+#include <wsutil/file_util.h>
+#include <wsutil/report_message.h>
+#include <wsutil/unicode-utils.h>
+
+#include "ft12.h"
 
 // Macros for readability
-#define FT12_START_BYTE 0x68
-#define FT12_END_BYTE 0x16
-#define BAOS_MAINSERVICE_CODE 0xF0
-#define BAOS_START_INDEX (start_byte_index + 5)
+#define BAOS_START_INDEX (start_byte_index + FT12_HEADER_LENGTH)
 
 // Protocol declaration
 static int proto_baos;
 
+// Tap declarations
+static int baos_tap;
+static int baos_heur_tap;
+static int baos_ack_tap;
+
 // Header field declarations
 static int hf_baos_ft12;
 static int hf_baos_ft12_header;
@@ -38,6 +51,18 @@ static int hf_baos_ft12_controllbyte;
 static int hf_baos_ft12_trailer;
 static int hf_baos_ft12_checksum;
 static int hf_baos_ft12_endbyte;
+static int hf_baos_ft12_skipped;
+static int hf_baos_ft12_ack;
+static int hf_baos_ft12_fixed_controlbyte;
+static int hf_baos_ft12_control_dir;
+static int hf_baos_ft12_control_prm;
+static int hf_baos_ft12_control_fcb;
+static int hf_baos_ft12_control_fcv;
+static int hf_baos_ft12_control_prm_function;
+static int hf_baos_ft12_control_sec_function;
+static int hf_baos_ft12_ack_to;
+static int hf_baos_ft12_ack_in;
+static int hf_baos_ft12_ack_latency;
 static int hf_baos_baos_payload;
 static int hf_baos_baos_mainservice;
 static int hf_baos_baos_subservice;
@@ -48,16 +73,31 @@ static int hf_baos_server_item_id;
 static int hf_baos_server_item_length;
 static int hf_baos_server_item_data;
 static int hf_baos_si_hardware_type;
-static int hf_baos_si_version;
+static int hf_baos_si_hardware_version;
+static int hf_baos_si_firmware_version;
+static int hf_baos_si_app_version;
+static int hf_baos_si_proto_version_bin;
+static int hf_baos_si_proto_version_web;
+static int hf_baos_si_proto_version_rest;
 static int hf_baos_si_version_major;
 static int hf_baos_si_version_minor;
-static int hf_baos_si_knx_man_code;
+static int hf_baos_si_knx_man_code_dev;
+static int hf_baos_si_knx_man_code_app;
 static int hf_baos_si_app_id;
 static int hf_baos_si_serial_number;
 static int hf_baos_si_time_since_reset;
+static int hf_baos_si_bus_connected;
+static int hf_baos_si_programming_mode;
+static int hf_baos_si_indication_sending;
+static int hf_baos_si_max_buffer_size;
+static int hf_baos_si_current_buffer_size;
+static int hf_baos_si_server_item_desc_str_len;
+// Fields shared by several server items before each of them got its own,
+// added hidden so that existing display filters still match
+static int hf_baos_si_version;
+static int hf_baos_si_knx_man_code;
 static int hf_baos_si_server_item_status;
 static int hf_baos_si_buffer_size;
-static int hf_baos_si_server_item_desc_str_len;
 static int hf_baos_si_baudrate;
 static int hf_baos_si_knx_address;
 static int hf_baos_si_knx_address_area;
@@ -84,75 +124,83 @@ static int hf_baos_dp_config_update_on_res;
 static int hf_baos_dp_dpt;
 static int hf_baos_dp_length;
 static int hf_baos_dp_value;
+static int hf_baos_dp_value_bool;
+static int hf_baos_dp_value_unsigned;
+static int hf_baos_dp_value_signed;
+static int hf_baos_dp_value_float;
+static int hf_baos_dp_value_text;
+static int hf_baos_dp_catalog_dpt;
+static int hf_baos_dp_catalog_value_type;
+static int hf_baos_dp_device_dpt;
 static int hf_baos_dp_filter;
 static int hf_baos_start_param_byte;
 static int hf_baos_nr_of_param_bytes;
 static int hf_baos_param_byte;
+static int hf_baos_param_byte_prev_write;
 static int hf_baos_start_desc_string;
 static int hf_baos_nr_of_desc_strings;
 static int hf_baos_desc_string_len;
 static int hf_baos_desc_string;
+static int hf_baos_buffer_size;
+static int hf_baos_buffer_utilization;
+static int hf_baos_request_in;
+static int hf_baos_response_in;
+static int hf_baos_response_time;
+static int hf_baos_poll_changed_dps;
+static int hf_baos_poll_unchanged_dps;
+static int hf_baos_poll_wasted_bytes;
+static int hf_baos_dp_trans_start_in;
+static int hf_baos_dp_trans_time;
+static int hf_baos_dp_write_req_in;
+static int hf_baos_dp_write_res_in;
+static int hf_baos_dp_write_ind_in;
+static int hf_baos_dp_write_res_time;
+static int hf_baos_dp_write_ind_time;
+static int hf_baos_dp_write_latency;
+static int hf_baos_bus_load_rate;
+static int hf_baos_bus_load_distinct_dps;
+static int hf_baos_bus_load_peak_rate;
+static int hf_baos_bus_load_peak_in;
+static int hf_baos_heur_result;
 
 // Expert info declarations
 static expert_field ei_ft12_incomplete_frame;
 static expert_field ei_ft12_checksum_error;
+static expert_field ei_ft12_resync;
+static expert_field ei_baos_truncated;
+static expert_field ei_baos_buffer_nearly_full;
+static expert_field ei_baos_buffer_exceeded;
+static expert_field ei_baos_poll_overlap;
+static expert_field ei_baos_poll_repeated;
+static expert_field ei_baos_poll_no_changes;
+static expert_field ei_baos_dp_trans_stuck;
+static expert_field ei_baos_dp_trans_failed;
+static expert_field ei_baos_bus_storm;
+static expert_field ei_baos_state_budget;
+
+// Preferences
+static unsigned pref_buffer_warning_threshold = 90;
+static const char *pref_dp_catalog_file = "";
+static unsigned pref_trans_stuck_threshold = 5000;
+static unsigned pref_bus_load_window = 1000;
+static unsigned pref_bus_storm_threshold = 50;
+static unsigned pref_state_budget = 0;
+static bool pref_heur_result_field = false;
 
 // ETT subtree declarations
 static int ett_baos;
 static int ett_ft12;
 static int ett_ft12_header;
 static int ett_ft12_trailer;
+static int ett_ft12_control;
 static int ett_baos_payload;
-
-// Refer to the BAOS documentation to
-// find out more about the available subservices.
-enum SUBSERVICE_CODES
-{
-    GET_SERVER_ITEM_REQ_CODE        = 0x01,
-    SET_SERVER_ITEM_REQ_CODE        = 0x02,
-    GET_DATAPOINT_DESC_REQ_CODE     = 0x03,
-    GET_DESC_STRING_REQ_CODE        = 0x04,
-    GET_DATAPOINT_VALUE_REQ_CODE    = 0x05,
-    SET_DATAPOINT_VALUE_REQ_CODE    = 0x06,
-    GET_PARAMETER_BYTE_REQ_CODE     = 0x07,
-    SET_PARAMETER_BYTE_REQ_CODE     = 0x08,
-    GET_SERVER_ITEM_RES_CODE        = 0x81,
-    SET_SERVER_ITEM_RES_CODE        = 0x82,
-    GET_DATAPOINT_DESC_RES_CODE     = 0x83,
-    GET_DESC_STRING_RES_CODE        = 0x84,
-    GET_DATAPOINT_VALUE_RES_CODE    = 0x85,
-    SET_DATAPOINT_VALUE_RES_CODE    = 0x86,
-    GET_PARAMETER_BYTE_RES_CODE     = 0x87,
-    SET_PARAMETER_BYTE_RES_CODE     = 0x88,
-    DATAPOINT_VALUE_IND_CODE        = 0xC1,
-    SERVER_ITEM_IND_CODE            = 0xC2
-};
-
-// Refer to Appendix B in the BAOS documentation
-// to find out more about the available error codes.
-enum OBJECT_SERVER_RESPONSE_CODES
-{
-    SUCCESS                 = 0x00,
-    INTERNAL_ERROR          = 0x01,
-    NO_ELEMENT_FOUND        = 0x02,
-    BUFFER_TOO_SMALL        = 0x03,
-    ITEM_NOT_WRITABLE       = 0x04,
-    SERVICE_NOT_SUPPORTED   = 0x05,
-    BAD_SERVICE_PARAMETER   = 0x06,
-    BAD_ID                  = 0x07,
-    BAD_COMMAND_VALUE       = 0x08,
-    BAD_LENGTH              = 0x09,
-    MESSAGE_INCONSISTENT    = 0x0A,
-    OBJECT_SERVER_BUSY      = 0x0B
-};
-
-enum CONTROL_BYTES
-{
-    CR_TX_ODD   = 0x73,
-    CR_TX_EVEN  = 0x53,
-    CR_RX_ODD   = 0xF3,
-    CR_RX_EVEN  = 0xD3
-};
+static int ett_baos_server_item;
+static int ett_baos_si_version;
+static int ett_baos_si_knx_address;
+static int ett_baos_dp;
+static int ett_baos_dp_state;
+static int ett_baos_dp_config;
+static int ett_baos_desc_string;
 
 enum BAUDRATES
 {
@@ -290,6 +338,40 @@ enum DP_CONFIG_FLAGS_TRANS_PRIOS
     LOW_PRIO    = 0b11
 };
 
+// Kinds of state kept for a device, whose memory is accounted
+enum BAOS_MEM_CATEGORIES
+{
+    BAOS_MEM_FRAMES,            // First pass results of the telegrams
+    BAOS_MEM_DP_HISTORY,        // Last known values of the datapoints
+    BAOS_MEM_DP_NAMES,          // Names and DPTs reported by the device
+    BAOS_MEM_PARAM_IMAGE,
+    BAOS_MEM_TRANSACTIONS,      // Transmissions and writes of datapoints
+    BAOS_MEM_BUS_LOAD,
+    BAOS_MEM_NR_OF_CATEGORIES
+};
+
+// Outcomes of the heuristic, ordered by how far
+// a USB transfer got into the FT 1.2 + BAOS pattern
+enum BAOS_HEUR_RESULTS
+{
+    BAOS_HEUR_TOO_SHORT,
+    BAOS_HEUR_NO_START_BYTE,
+    BAOS_HEUR_BAD_CONTROL_BYTE,
+    BAOS_HEUR_BAD_MAIN_SERVICE,
+    BAOS_HEUR_BAD_LENGTH,
+    BAOS_HEUR_ACCEPTED,
+    BAOS_HEUR_ACCEPTED_CHECKSUM_ERROR,
+    BAOS_HEUR_ACCEPTED_INCOMPLETE,
+    BAOS_HEUR_ACCEPTED_LINK_FRAME
+};
+
+// Approximate size of a wmem map entry or list frame
+// holding a pointer to the accounted state
+#define BAOS_MEM_ENTRY_SIZE (3 * sizeof(void *))
+
+// Datapoints listed in the info column, further ones are cut short
+#define BAOS_COL_INFO_MAX_DPS 4
+
 static const value_string vs_ft12_control_bytes[] = {
     {CR_TX_EVEN, "TX - Even"},
     {CR_TX_ODD, "TX - Odd"},
@@ -298,6 +380,41 @@ static const value_string vs_ft12_control_bytes[] = {
     {0, NULL}
 };
 
+// Function codes of frames sent by the primary station
+static const value_string vs_ft12_prm_functions[] = {
+    {FT12_PRM_RESET_LINK, "Reset of remote link"},
+    {FT12_PRM_RESET_USER_PROCESS, "Reset of user process"},
+    {0x03, "User data, confirm expected"},
+    {0x04, "User data, no reply expected"},
+    {0x08, "Request for access demand"},
+    {FT12_PRM_REQUEST_STATUS, "Request status of link"},
+    {0x0A, "Request user data class 1"},
+    {0x0B, "Request user data class 2"},
+    {0, NULL}
+};
+
+// Function codes of frames sent by the secondary station
+static const value_string vs_ft12_sec_functions[] = {
+    {FT12_SEC_ACK, "ACK: positive acknowledgement"},
+    {FT12_SEC_NACK, "NACK: message not accepted, link busy"},
+    {0x08, "User data"},
+    {0x09, "NACK: requested data not available"},
+    {FT12_SEC_STATUS, "Status of link or access demand"},
+    {0x0E, "Link service not functioning"},
+    {0x0F, "Link service not implemented"},
+    {0, NULL}
+};
+
+static const true_false_string tfs_ft12_control_dir = {
+    "From the BAOS device",
+    "To the BAOS device"
+};
+
+static const true_false_string tfs_ft12_control_prm = {
+    "From the primary station",
+    "From the secondary station"
+};
+
 // Refer to Appendix B in the BAOS documentation
 // to find out more about the available error codes.
 static const value_string vs_object_server_response[] = {
@@ -352,6 +469,10 @@ static const value_string vs_baos_dpts[] = {
     {0, NULL}
 };
 
+// Extended value string for fast lookups. DPT 1 to 19 and DPT 20 to 251
+// are two contiguous runs, so the table is searched binary.
+static value_string_ext vs_baos_dpts_ext = VALUE_STRING_EXT_INIT(vs_baos_dpts);
+
 // Refer to Appendix C in the BAOS documentation
 // to find out more about the available datapoint value types.
 static const value_string vs_baos_dp_value_types[] = {
@@ -387,9 +508,19 @@ static const value_string vs_dp_config_flags_trans_prios[] = {
     {0, NULL}
 };
 
-static const true_false_string vs_server_item_status = {
-    "True",
-    "False"
+static const true_false_string vs_si_bus_connection_state = {
+    "Connected",
+    "Disconnected"
+};
+
+static const true_false_string vs_si_programming_mode = {
+    "Active",
+    "Inactive"
+};
+
+static const true_false_string vs_si_indication_sending = {
+    "Enabled",
+    "Disabled"
 };
 
 // Refer to the BAOS documentation to
@@ -416,6 +547,10 @@ static const value_string vs_subservices[] = {
     {0, NULL}
 };
 
+// Extended value string for fast lookups. Requests, responses and
+// indications are three contiguous runs, so the table is searched binary.
+static value_string_ext vs_subservices_ext = VALUE_STRING_EXT_INIT(vs_subservices);
+
 // Refer to Appendix A in the BAOS documentation to
 // find out more about the available server items.
 // For now, only the server items are present, which are
@@ -444,6 +579,56 @@ static const value_string vs_server_items[] = {
     {0, NULL}
 };
 
+// Extended value string for fast lookups. Server item IDs
+// are contiguous, so the table is indexed directly.
+static value_string_ext vs_server_items_ext = VALUE_STRING_EXT_INIT(vs_server_items);
+
+// Runs of enum values, each of which needs a label in a value string
+typedef struct _enum_range_t
+{
+    uint32_t first;
+    uint32_t last;
+} enum_range_t;
+
+// The values labelled by the extended value strings, which are checked
+// at registration, since lookups silently get slower when the tables
+// are not sorted and miss values which have no label
+static const enum_range_t subservice_ranges[] = {
+    {GET_SERVER_ITEM_REQ_CODE, SET_PARAMETER_BYTE_REQ_CODE},
+    {GET_SERVER_ITEM_RES_CODE, SET_PARAMETER_BYTE_RES_CODE},
+    {DATAPOINT_VALUE_IND_CODE, SERVER_ITEM_IND_CODE}
+};
+
+static const enum_range_t dpt_ranges[] = {
+    {DPT1, DPT19},
+    {DPT20, DPT251},
+    {UNKNOWN_DPT, UNKNOWN_DPT}
+};
+
+static const enum_range_t server_item_ranges[] = {
+    {HARDWARE_TYPE, INDIVIDUAL_ADDRESS}
+};
+
+// Number of values in a run of an enum
+#define ENUM_RANGE_LENGTH(first, last) ((last) - (first) + 1)
+
+// The extended value strings label every value of their runs once,
+// plus the terminating entry. Their order is checked at registration,
+// since the values of a static array aren't constant expressions.
+static_assert(array_length(vs_subservices) ==
+              ENUM_RANGE_LENGTH(GET_SERVER_ITEM_REQ_CODE, SET_PARAMETER_BYTE_REQ_CODE) +
+              ENUM_RANGE_LENGTH(GET_SERVER_ITEM_RES_CODE, SET_PARAMETER_BYTE_RES_CODE) +
+              ENUM_RANGE_LENGTH(DATAPOINT_VALUE_IND_CODE, SERVER_ITEM_IND_CODE) + 1,
+              "vs_subservices must label every subservice once");
+static_assert(array_length(vs_baos_dpts) ==
+              ENUM_RANGE_LENGTH(DPT1, DPT19) +
+              ENUM_RANGE_LENGTH(DPT20, DPT251) +
+              ENUM_RANGE_LENGTH(UNKNOWN_DPT, UNKNOWN_DPT) + 1,
+              "vs_baos_dpts must label every DPT once");
+static_assert(array_length(vs_server_items) ==
+              ENUM_RANGE_LENGTH(HARDWARE_TYPE, INDIVIDUAL_ADDRESS) + 1,
+              "vs_server_items must label every server item once");
+
 // Refer to the BAOS documentation to
 // find out more about the available datapoint commands.
 static const value_string vs_dp_commands[] = {
@@ -463,6 +648,29 @@ static const value_string vs_dp_filters[] = {
     {0, NULL}
 };
 
+static const value_string vs_baos_mem_categories[] = {
+    {BAOS_MEM_FRAMES, "Telegrams"},
+    {BAOS_MEM_DP_HISTORY, "Datapoint history"},
+    {BAOS_MEM_DP_NAMES, "Datapoint names and DPTs"},
+    {BAOS_MEM_PARAM_IMAGE, "Parameter byte image"},
+    {BAOS_MEM_TRANSACTIONS, "Transmissions and writes"},
+    {BAOS_MEM_BUS_LOAD, "Bus load"},
+    {0, NULL}
+};
+
+static const value_string vs_baos_heur_results[] = {
+    {BAOS_HEUR_TOO_SHORT, "Rejected: too short"},
+    {BAOS_HEUR_NO_START_BYTE, "Rejected: no FT 1.2 start bytes"},
+    {BAOS_HEUR_BAD_CONTROL_BYTE, "Rejected: bad control byte"},
+    {BAOS_HEUR_BAD_MAIN_SERVICE, "Rejected: main service not BAOS"},
+    {BAOS_HEUR_BAD_LENGTH, "Rejected: FT 1.2 length too small"},
+    {BAOS_HEUR_ACCEPTED, "Accepted"},
+    {BAOS_HEUR_ACCEPTED_CHECKSUM_ERROR, "Accepted with checksum error"},
+    {BAOS_HEUR_ACCEPTED_INCOMPLETE, "Accepted without end byte"},
+    {BAOS_HEUR_ACCEPTED_LINK_FRAME, "Accepted: FT 1.2 acknowledgement or fixed length frame"},
+    {0, NULL}
+};
+
 static const value_string vs_dp_state_valid_flags[] = {
     {OBJECT_VAL_UNKNOWN, "Object value is unknown"},
     {OBJECT_ALREADY_RECEIVED, "Object has already been received"},
@@ -489,64 +697,704 @@ static const value_string vs_dp_state_trans_states[] = {
     {0, NULL}
 };
 
+// Describes how the data of a server item is dissected.
+// If bits is not NULL, the data is added as a bitmask
+// with the given subtree, otherwise as a single item.
+// If shared_hf is not NULL, the data is also added
+// as a hidden item of the field formerly used for it.
+typedef struct _server_item_desc_t
+{
+    int *hf;
+    uint8_t length;
+    int *ett;
+    int * const *bits;
+    int *shared_hf;
+} server_item_desc_t;
+
+static int * const si_version_bits[] = {
+    &hf_baos_si_version_major,
+    &hf_baos_si_version_minor,
+    NULL
+};
+
+static int * const si_knx_address_bits[] = {
+    &hf_baos_si_knx_address_area,
+    &hf_baos_si_knx_address_line,
+    &hf_baos_si_knx_address_device,
+    NULL
+};
+
+// Refer to Appendix A in the BAOS documentation to
+// find out more about the data of the server items.
+// Indexed by server item ID, so that the lookup of
+// a server item's typed field takes constant time.
+static const server_item_desc_t server_item_descs[] = {
+    [HARDWARE_TYPE]             = {&hf_baos_si_hardware_type, 6, NULL, NULL},
+    [HARDWARE_VERSION]          = {&hf_baos_si_hardware_version, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [FIRMWARE_VERSION]          = {&hf_baos_si_firmware_version, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [KNX_MANUFACTURER_CODE_DEV] = {&hf_baos_si_knx_man_code_dev, 2, NULL, NULL, &hf_baos_si_knx_man_code},
+    [KNX_MANUFACTURER_CODE_APP] = {&hf_baos_si_knx_man_code_app, 2, NULL, NULL, &hf_baos_si_knx_man_code},
+    [APPLICATION_ID_ETS]        = {&hf_baos_si_app_id, 2, NULL, NULL},
+    [APPLICATION_VERSION_ETS]   = {&hf_baos_si_app_version, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [SERIAL_NUMBER]             = {&hf_baos_si_serial_number, 6, NULL, NULL},
+    [TIME_SINCE_RESET]          = {&hf_baos_si_time_since_reset, 4, NULL, NULL},
+    [BUS_CONNECTION_STATE]      = {&hf_baos_si_bus_connected, 1, NULL, NULL, &hf_baos_si_server_item_status},
+    [MAX_BUFFER_SIZE]           = {&hf_baos_si_max_buffer_size, 2, NULL, NULL, &hf_baos_si_buffer_size},
+    [LENGTH_OF_DESC_STRING]     = {&hf_baos_si_server_item_desc_str_len, 2, NULL, NULL},
+    [BAUDRATE]                  = {&hf_baos_si_baudrate, 1, NULL, NULL},
+    [CURRENT_BUFF_SIZE]         = {&hf_baos_si_current_buffer_size, 2, NULL, NULL, &hf_baos_si_buffer_size},
+    [PROGRAMMING_MODE]          = {&hf_baos_si_programming_mode, 1, NULL, NULL, &hf_baos_si_server_item_status},
+    [PROTO_VERSION_BIN]         = {&hf_baos_si_proto_version_bin, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [INDICATION_SENDING]        = {&hf_baos_si_indication_sending, 1, NULL, NULL, &hf_baos_si_server_item_status},
+    [PROTO_VERSION_WEBSERVICE]  = {&hf_baos_si_proto_version_web, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [PROTO_VERSION_RESTSERVICE] = {&hf_baos_si_proto_version_rest, 1, &ett_baos_si_version, si_version_bits, &hf_baos_si_version},
+    [INDIVIDUAL_ADDRESS]        = {&hf_baos_si_knx_address, 2, &ett_baos_si_knx_address, si_knx_address_bits}
+};
+
+// Device profile assembled from the server items
+// reported by a BAOS device in GetServerItem.Res
+// and ServerItem.Ind telegrams
+typedef struct _baos_device_profile_t
+{
+    uint32_t known_server_items;    // Bit n is set if server item n has been seen
+    uint8_t hardware_type[6];
+    uint8_t hardware_version;
+    uint8_t firmware_version;
+    uint16_t knx_man_code_dev;
+    uint16_t knx_man_code_app;
+    uint16_t app_id;
+    uint8_t app_version;
+    uint8_t serial_number[6];
+    uint16_t individual_address;
+    uint16_t max_buffer_size;
+    uint16_t current_buffer_size;
+    uint32_t first_frame;
+    uint32_t last_frame;
+} baos_device_profile_t;
+
+// Flags of a GetDatapointValue.Req compared to the previous one
+#define BAOS_POLL_OVERLAP   0x01    // Range overlaps the range of the previous poll
+#define BAOS_POLL_REPEATED  0x02    // Same poll as before, which returned no changes
+
+// Efficiency of a GetDatapointValue.Req / .Res transaction.
+// Shared by the first pass results of request and response.
+typedef struct _baos_poll_result_t
+{
+    uint16_t start_dp_id;
+    uint16_t nr_of_dps;
+    uint8_t filter;
+    uint8_t flags;
+    bool is_answered;
+    uint16_t returned_dps;
+    uint16_t changed_dps;
+    uint32_t wasted_bytes;
+} baos_poll_result_t;
+
+// Write of a datapoint value that goes out on the bus, followed from
+// SetDatapointValue.Req to SetDatapointValue.Res to DatapointValue.Ind
+typedef struct _baos_dp_write_t
+{
+    uint16_t dp_id;
+    uint8_t command;
+    uint32_t req_frame;
+    nstime_t req_ts;
+    uint32_t res_frame;             // 0 until the response is seen
+    nstime_t res_ts;
+    uint32_t ind_frame;             // 0 until the confirming indication is seen
+    nstime_t ind_ts;
+    wmem_map_t *ind_dp_writes;      // Writes of the confirming indication
+} baos_dp_write_t;
+
+
+// Bus load seen in a DatapointValue.Ind, estimated
+// over the sliding window that ends with the telegram
+typedef struct _baos_bus_load_t
+{
+    double rate;                    // Updated datapoints per second
+    uint32_t distinct_dps;          // Distinct updated datapoints in the window
+    double peak_rate;               // Highest rate of the device so far
+    uint32_t peak_frame;
+    bool is_storm;                  // Rate at or above the bus storm threshold
+} baos_bus_load_t;
+
+// Datapoint update from the bus in the sliding window
+typedef struct _baos_bus_load_event_t
+{
+    nstime_t ts;
+    uint16_t dp_id;
+} baos_bus_load_event_t;
+
+// Sliding window of datapoint updates from the bus.
+// Events are kept in a ring buffer that grows when needed.
+typedef struct _baos_bus_load_window_t
+{
+    baos_bus_load_event_t *events;
+    uint32_t capacity;
+    uint32_t head;                  // Oldest event
+    uint32_t count;
+    wmem_map_t *dp_counts;          // Maps datapoint IDs to their number of events in the window
+    double peak_rate;
+    uint32_t peak_frame;
+} baos_bus_load_window_t;
+
+// Results of the first pass stored for every BAOS telegram,
+// so that later passes show the same analysis
+typedef struct _baos_frame_data_t
+{
+    uint32_t frame_num;
+    nstime_t abs_ts;
+    uint16_t telegram_length;       // Length of the whole FT 1.2 frame
+    uint16_t buffer_size;           // Buffer size in effect, 0 if unknown
+    uint16_t requested_buffer_size; // Current buffer size set by a SetServerItem.Req, 0 if none
+    uint8_t start_byte_index;       // Found by the heuristic
+    uint8_t checksum;               // Calculated FT 1.2 checksum
+    bool is_checksum_known;         // Checksum calculated, trailer present
+    struct _baos_frame_data_t *matched; // Matching request or response
+    baos_poll_result_t *poll;       // Only set for GetDatapointValue telegrams
+    uint32_t *param_prev_writes;    // Previous write frame per parameter byte, 0 if none
+    wmem_map_t *dp_transmissions;   // Maps datapoint IDs to baos_dp_transmission_t
+    wmem_map_t *dp_writes;          // Maps datapoint IDs to baos_dp_write_t
+    wmem_map_t *dp_decoded;         // Maps datapoint IDs to baos_dp_decoded_t
+    baos_bus_load_t *bus_load;      // Only set for DatapointValue.Ind telegrams
+    struct _baos_frame_data_t *ack; // Acknowledgement of the frame, or the frame acknowledged
+    bool is_ack;                    // Single character acknowledgement or secondary frame
+    bool is_from_device;            // FT 1.2 direction bit set
+    bool is_over_budget;            // Seen after the device's state budget was used up, not analyzed
+} baos_frame_data_t;
+
+// Last known value of a datapoint
+typedef struct _baos_dp_history_t
+{
+    uint32_t last_frame;
+    uint8_t state;
+    uint8_t length;
+    uint8_t value[14];
+    uint32_t trans_start_frame;     // Frame the pending transmission was first seen in, 0 if none
+    nstime_t trans_start_ts;
+    uint16_t dp_id;
+    wmem_list_frame_t *lru_frame;   // Position in the device's list of least recently updated datapoints
+    struct _baos_dp_transmission_t *trans_start; // Record of the pending transmission in its start frame, NULL if none
+    wmem_list_frame_t *trans_frame; // Position in the device's list of pending transmissions, NULL if not listed
+} baos_dp_history_t;
+
+// Datapoint value decoded on the first pass, so that later passes
+// show the DPT that was known then without decoding the value again
+typedef struct _baos_dp_decoded_t
+{
+    double numeric_value;           // Only valid for numeric DPTs
+    uint8_t dpt;
+    bool is_dpt_from_device;        // DPT from GetDatapointDescription.Res, not from the catalog
+} baos_dp_decoded_t;
+
+// Transmission of a datapoint value to the bus, tracked across frames
+typedef struct _baos_dp_transmission_t
+{
+    uint32_t start_frame;           // Frame the transmission was first seen requested or in progress
+    nstime_t duration;              // Time since start_frame
+    uint8_t trans_state;            // Transmission state in this frame
+    bool is_complete;               // Ended with IDLE_OK or IDLE_ERROR in this frame
+    bool is_stuck;                  // Still pending after the stuck threshold
+    bool is_ended;                  // Start frame only: the transmission was seen ending later
+} baos_dp_transmission_t;
+
+// Parameter byte of the image reconstructed from
+// GetParameterByte.Res and SetParameterByte.Req telegrams
+typedef struct _baos_param_byte_t
+{
+    uint16_t id;
+    uint8_t value;
+    uint32_t last_frame;            // Frame the value was last seen in
+    uint32_t last_write_frame;      // Last SetParameterByte.Req, 0 if never written
+} baos_param_byte_t;
+
+// Name of a datapoint from a GetDescriptionString.Res. Earlier names
+// of a datapoint are kept, so that every frame is labeled with the name
+// known when it was first dissected.
+typedef struct _baos_dp_name_t
+{
+    const char *name;               // Interned in baos_dp_name_pool
+    uint32_t first_frame;           // Frame the name was learned in
+    struct _baos_dp_name_t *prev;   // Name the datapoint had before, NULL if none
+} baos_dp_name_t;
+
+// State kept for every BAOS device found in the capture.
+// Filled on the first pass only.
+typedef struct _baos_conv_data_t
+{
+    uint32_t index;                 // Device number in order of appearance
+    const char *name;               // Device label used in statistics
+    baos_device_profile_t device_profile;
+    baos_frame_data_t *pending_requests[SET_PARAMETER_BYTE_REQ_CODE + 1]; // Unanswered request per subservice
+    baos_frame_data_t *last_poll;   // Last GetDatapointValue.Req
+    baos_frame_data_t *unacked_frame; // Last frame of a primary station, until it's acknowledged
+    wmem_map_t *dp_history;         // Maps datapoint IDs to baos_dp_history_t
+    wmem_map_t *dp_names;           // Maps datapoint IDs to their latest baos_dp_name_t
+    wmem_map_t *dp_dpts;            // Maps datapoint IDs to DPTs from GetDatapointDescription.Res
+    wmem_tree_t *param_image;       // Maps parameter byte IDs to baos_param_byte_t
+    wmem_map_t *pending_writes;     // Maps datapoint IDs to unconfirmed baos_dp_write_t
+    baos_bus_load_window_t bus_load_window;
+    wmem_list_t *dp_history_lru;    // baos_dp_history_t, least recently updated first
+    wmem_list_t *pending_transmissions; // baos_dp_history_t with a transmission not yet stuck, oldest first
+    uint32_t dp_history_evictions;
+    uint32_t frames_over_budget;    // Telegrams not analyzed since the state budget was used up
+    size_t mem_usage[BAOS_MEM_NR_OF_CATEGORIES]; // Bytes of state by category
+} baos_conv_data_t;
+
+// Outcome of the heuristic for a USB transfer,
+// handed to the taps whether it was accepted or not
+typedef struct _baos_heur_info_t
+{
+    uint8_t result;                 // enum BAOS_HEUR_RESULTS
+    uint32_t length;                // Bytes of the USB transfer
+} baos_heur_info_t;
+
+// FT 1.2 acknowledgement, handed to the taps
+typedef struct _baos_ack_info_t
+{
+    const baos_conv_data_t *conv_data;
+    const baos_frame_data_t *frame_data;    // The acknowledgement, linked to the frame it acknowledges
+    bool is_negative;               // Secondary frame with a NACK function code
+} baos_ack_info_t;
+
+// Datapoint value observed in a telegram, handed to the taps
+typedef struct _baos_dp_value_t
+{
+    uint16_t dp_id;
+    uint8_t state;                  // Datapoint state, or command of SetDatapointValue.Req
+    const char *value;              // Decoded value, or raw bytes if the DPT is unknown
+} baos_dp_value_t;
+
+// Information about a single BAOS telegram,
+// shared by the sub-dissectors and handed to the taps
+typedef struct _baos_info_t
+{
+    uint8_t subservice;
+    baos_conv_data_t *conv_data;
+    baos_frame_data_t *frame_data;
+    int buffer_utilization;         // In percent, -1 if buffer size is unknown
+    uint16_t start_param_byte;
+    uint16_t nr_of_param_bytes;     // Parameter bytes in the telegram
+    const uint8_t *param_bytes;     // Only set for GetParameterByte.Res and SetParameterByte.Req
+    wmem_array_t *dp_values;        // Datapoint values as baos_dp_value_t, NULL if there are none
+} baos_info_t;
+
+// Parameter byte image of a device in the parameter byte report
+typedef struct _baos_param_report_device_t
+{
+    const char *name;
+    wmem_tree_t *param_image;       // Maps parameter byte IDs to baos_param_byte_t
+} baos_param_report_device_t;
+
+// State of the datapoint value export (tshark -z baos,dpvalues[,filter])
+typedef struct _baos_dp_export_t
+{
+    char *filter;
+    GString *buffer;                // Rows not yet written by the draw callback
+} baos_dp_export_t;
+
+// Response of the object server to the writes of a SetDatapointValue.Req
+typedef struct _baos_dp_write_response_t
+{
+    packet_info *pinfo;
+    baos_conv_data_t *conv_data;
+    bool is_error;                  // Response code other than success
+} baos_dp_write_response_t;
+
+// Context of the write latency statistics tree
+// while it walks the writes of a telegram
+typedef struct _baos_write_stats_ctx_t
+{
+    stats_tree *st;
+    const baos_info_t *baos_info;
+    packet_info *pinfo;
+} baos_write_stats_ctx_t;
+
+// Rows of the datapoint value export are written in chunks of this size
+#define BAOS_DP_EXPORT_BUFFER_SIZE 65536
+#define BAOS_DP_EXPORT_HEADER "time,frame,device,subservice,dp_id,name,value,state,command\n"
+
+// State of the parameter byte report (tshark -z baos,params[,filter])
+typedef struct _baos_param_report_t
+{
+    wmem_allocator_t *scope;
+    char *filter;
+    wmem_tree_t *devices;           // Maps device numbers to baos_param_report_device_t
+} baos_param_report_t;
+
+// Maps device keys to the state of the BAOS devices
+static wmem_map_t *baos_conv_data_map;
+static uint32_t baos_device_count;
+
+// Datapoint as listed in the datapoint catalog file.
+// The name is not copied, but points into the mapped file.
+typedef struct _baos_dp_catalog_entry_t
+{
+    uint32_t name_offset;
+    uint16_t name_length;           // 0 if no name is given
+    uint8_t dpt;                    // One of BAOS_DPTS, UNKNOWN_DPT if not given
+    uint8_t value_type;             // UINT8_MAX if not given
+} baos_dp_catalog_entry_t;
+
+// Datapoint catalog, indexed by datapoint ID
+typedef struct _baos_dp_catalog_t
+{
+    char *file_name;
+    GMappedFile *mapped_file;
+    int64_t file_size;
+    time_t file_mtime;
+    baos_dp_catalog_entry_t *entries;
+    uint32_t nr_of_entries;         // Highest listed datapoint ID + 1
+    uint32_t nr_of_allocated_entries;
+} baos_dp_catalog_t;
+
+static baos_dp_catalog_t baos_dp_catalog;
+
+// Value fields registered for the datapoints of the catalog
+static hf_register_info *dp_value_hf;
+static unsigned nr_of_dp_value_hf;
+static int *dp_value_hf_ids;        // Indexed by datapoint ID, 0 if the datapoint has no field
+static uint32_t nr_of_dp_value_hf_ids;
+
+// Interned datapoint names, shared by all devices
+static wmem_map_t *baos_dp_name_pool;
+
 // Function prototypes
 uint8_t
 check_serial_baos_pattern(tvbuff_t *tvb);
 
+uint8_t
+get_baos_heur_reject_reason(tvbuff_t *tvb);
+
+void
+queue_baos_heur_result(tvbuff_t *tvb, packet_info *pinfo, uint8_t result);
+
 bool
-check_packet_integrity(tvbuff_t *tvb, uint8_t trailer_start_index);
+check_packet_integrity(tvbuff_t *tvb, uint16_t trailer_start_index);
 
 uint32_t
-calculateChecksum(tvbuff_t *tvb, uint8_t start_byte_index, uint8_t trailer_start_index);
+calculateChecksum(tvbuff_t *tvb, uint8_t start_byte_index, uint16_t trailer_start_index);
+
+int
+get_item_length_in_tvb(tvbuff_t *tvb, uint16_t item_offset, uint32_t item_length);
 
 void
-dissect_get_server_item_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_item_truncation(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, uint16_t nr_of_items_found, uint16_t nr_of_items, const char *item_name);
+
+const char *
+get_dp_state_summary(wmem_allocator_t *scope, uint8_t dp_state);
 
 void
-dissect_long_server_item_telegram(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_get_server_item_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+
+uint32_t
+get_baos_device_key(packet_info *pinfo, const usb_address_t **usb_device_addr);
+
+baos_conv_data_t *
+get_baos_conv_data(packet_info *pinfo);
+
+baos_frame_data_t *
+get_baos_frame_data(packet_info *pinfo, baos_conv_data_t *conv_data);
 
 void
-dissect_get_datapoint_desc_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+match_baos_transaction(packet_info *pinfo, baos_info_t *baos_info);
 
 void
-dissect_get_desc_string_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_transaction_info(tvbuff_t *tvb, proto_tree *baos_payload_tree, baos_info_t *baos_info);
 
 void
-dissect_get_datapoint_value_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+match_ft12_ack(packet_info *pinfo, baos_conv_data_t *conv_data, baos_frame_data_t *frame_data, uint8_t type, uint8_t control_byte);
 
 void
-dissect_set_datapoint_value_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_ft12_ack_info(tvbuff_t *tvb, proto_tree *ft12_tree, const baos_frame_data_t *frame_data);
+
+int
+dissect_ft12_link_frame(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, uint8_t type);
+
+bool
+update_dp_history(baos_conv_data_t *conv_data, tvbuff_t *tvb, packet_info *pinfo, uint16_t dp_id, uint8_t dp_state, uint16_t dp_value_offset, uint8_t dp_length);
 
 void
-dissect_get_parameter_byte_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+evict_dp_history(baos_conv_data_t *conv_data);
+
+size_t
+get_baos_mem_usage(const baos_conv_data_t *conv_data);
+
+bool
+is_state_budget_used_up(const baos_conv_data_t *conv_data);
 
 void
-dissect_set_parameter_byte_req(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+store_dp_name(baos_conv_data_t *conv_data, tvbuff_t *tvb, packet_info *pinfo, uint16_t dp_id, uint16_t desc_string_offset, uint16_t desc_string_len);
+
+bool
+load_dp_catalog(bool report_errors);
+
+bool
+parse_dp_catalog_number(const char *field, const char *field_end, uint32_t *number);
+
+void
+parse_dp_catalog_line(const char *content, const char *line, const char *line_end);
+
+const baos_dp_catalog_entry_t *
+get_dp_catalog_entry(uint16_t dp_id);
+
+char *
+get_dp_catalog_name(wmem_allocator_t *scope, uint16_t dp_id);
+
+enum ftenum
+get_dp_value_ftype(uint8_t dpt);
+
+void
+register_dp_value_fields(void);
+
+int
+get_dp_value_hf(uint16_t dp_id);
+
+void
+store_dp_dpt(baos_conv_data_t *conv_data, packet_info *pinfo, uint16_t dp_id, uint8_t dpt);
+
+uint8_t
+get_dp_dpt(const baos_conv_data_t *conv_data, uint16_t dp_id, bool *is_dpt_from_device);
+
+uint8_t
+get_dpt_min_length(uint8_t dpt);
+
+bool
+decode_dp_value_numeric(tvbuff_t *tvb, uint8_t dpt, uint16_t dp_value_offset, double *value);
+
+const char *
+dissect_dp_value_typed(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_value_offset, uint8_t dp_length);
+
+const char *
+get_dp_name(packet_info *pinfo, const baos_conv_data_t *conv_data, uint16_t dp_id);
+
+void
+add_dp_value(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t state, const char *value);
+
+const char *
+get_dp_label(packet_info *pinfo, const baos_conv_data_t *conv_data, uint16_t dp_id);
+
+void
+add_dp_label_to_col_info(packet_info *pinfo, uint16_t i, const char *dp_label);
+
+uint16_t
+update_param_image(wmem_tree_t *param_image, wmem_allocator_t *scope, const baos_info_t *baos_info, uint32_t frame_num, uint32_t *prev_writes);
+
+void
+dissect_param_bytes(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+track_dp_transmission(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t dp_state);
+
+void
+end_dp_transmission(baos_conv_data_t *conv_data, baos_dp_history_t *dp_history);
+
+void
+check_stuck_transmissions(packet_info *pinfo, baos_conv_data_t *conv_data);
+
+void
+dissect_dp_transmission(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_state_offset);
+
+void
+track_dp_write_request(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id, uint8_t command);
+
+void
+set_dp_write_response(void *key, void *value, void *userdata);
+
+void
+track_dp_write_response(packet_info *pinfo, baos_info_t *baos_info, bool is_error);
+
+void
+track_dp_write_confirmation(packet_info *pinfo, baos_info_t *baos_info, uint16_t dp_id);
+
+void
+dissect_dp_write(tvbuff_t *tvb, packet_info *pinfo, proto_tree *dp_tree, baos_info_t *baos_info, uint16_t dp_id, uint16_t dp_id_offset);
+
+void
+add_bus_load_event(baos_conv_data_t *conv_data, packet_info *pinfo, uint16_t dp_id);
+
+void
+update_bus_load(packet_info *pinfo, baos_info_t *baos_info);
+
+void
+dissect_bus_load(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, baos_info_t *baos_info);
+
+void
+analyze_poll_request(packet_info *pinfo, baos_info_t *baos_info, uint16_t start_dp_id, uint16_t nr_of_dps, uint8_t filter);
+
+void
+dissect_poll_result(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, baos_info_t *baos_info);
+
+void
+dissect_buffer_utilization(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t baos_payload_len, baos_info_t *baos_info);
+
+void
+update_device_profile(baos_device_profile_t *device_profile, tvbuff_t *tvb, packet_info *pinfo, uint16_t server_item_id, uint16_t server_item_data_offset);
+
+void
+dissect_server_item_data(tvbuff_t *tvb, proto_tree *server_item_tree, uint16_t server_item_id, uint16_t server_item_data_offset, uint8_t server_item_data_length);
 
 void
-dissect_set_server_item_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_long_server_item_telegram(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
 
 void
-dissect_get_datapoint_desc_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_get_datapoint_desc_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index);
 
 void
-dissect_get_desc_string_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_get_desc_string_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index);
 
 void
-dissect_get_datapoint_value_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_get_datapoint_value_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
 
 void
-dissect_set_datapoint_value_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_set_datapoint_value_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
 
 void
-dissect_get_parameter_byte_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_get_parameter_byte_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index);
 
 void
-dissect_set_parameter_byte_res(tvbuff_t *tvb, proto_tree *baos_payload_tree, uint8_t start_byte_index);
+dissect_set_parameter_byte_req(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_set_server_item_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_get_datapoint_desc_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_get_desc_string_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_get_datapoint_value_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_set_datapoint_value_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_get_parameter_byte_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index, baos_info_t *baos_info);
+
+void
+dissect_set_parameter_byte_res(tvbuff_t *tvb, packet_info *pinfo, proto_tree *baos_payload_tree, uint8_t start_byte_index);
 
 static bool
 dissect_baos_heur(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_);
 
+static bool
+dissect_baos_telegram(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, proto_tree **telegram_tree, bool is_heur);
+
+static int
+dissect_baos_ft12(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data _U_);
+
+void
+baos_init(void);
+
+void
+apply_baos_prefs(void);
+
+void
+baos_devices_stats_tree_init(stats_tree *st);
+
+void
+set_device_property_stat_node(stats_tree *st, int device_node, const char *property, const char *value);
+
+tap_packet_status
+baos_devices_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_buffer_stats_tree_init(stats_tree *st);
+
+tap_packet_status
+baos_buffer_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_poll_stats_tree_init(stats_tree *st);
+
+tap_packet_status
+baos_poll_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_trans_stats_tree_init(stats_tree *st);
+
+void
+baos_trans_stats_tree_tick(void *key, void *value, void *userdata);
+
+tap_packet_status
+baos_trans_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_write_stats_tree_init(stats_tree *st);
+
+void
+baos_write_stats_tree_tick(void *key, void *value, void *userdata);
+
+tap_packet_status
+baos_write_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_heur_stats_tree_init(stats_tree *st);
+
+tap_packet_status
+baos_heur_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_ack_stats_tree_init(stats_tree *st);
+
+tap_packet_status
+baos_ack_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_mem_stats_tree_init(stats_tree *st);
+
+void
+sum_baos_mem_usage(void *key, void *value, void *userdata);
+
+tap_packet_status
+baos_mem_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_bus_load_stats_tree_init(stats_tree *st);
+
+tap_packet_status
+baos_bus_load_stats_tree_packet(stats_tree *st, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_dp_export_append_field(GString *buffer, const char *field);
+
+void
+baos_dp_export_flush(baos_dp_export_t *export_data);
+
+void
+baos_dp_export_reset(void *tapdata);
+
+tap_packet_status
+baos_dp_export_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+void
+baos_dp_export_draw(void *tapdata);
+
+void
+baos_dp_export_init(const char *opt_arg, void *userdata);
+
+void
+baos_param_report_reset(void *tapdata);
+
+tap_packet_status
+baos_param_report_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt, const void *p, tap_flags_t flags);
+
+bool
+baos_param_report_draw_byte(const void *key, void *value, void *userdata);
+
+bool
+baos_param_report_draw_device(const void *key, void *value, void *userdata);
+
+void
+baos_param_report_draw(void *tapdata);
+
+void
+baos_param_report_init(const char *opt_arg, void *userdata);
+
+bool
+check_value_string(const char *name, const value_string *vs, const enum_range_t *ranges, size_t nr_of_ranges);
+
 void
 proto_register_baos(void);
 
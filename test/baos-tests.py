@@ -0,0 +1,384 @@
+#!/usr/bin/env python3
+#
+# baos-tests.py
+#
+# Regression tests of the BAOS dissector, driven by tshark
+# By Adam Rigely <adamrigely@pm.me>
+#
+# Every capture in captures/ is made by tools/baos-capture-gen.py from the
+# arguments in CAPTURES and holds a single kind of traffic. The fields
+# printed by tshark for a capture are compared with golden/<name>.txt,
+# and the time tshark takes to dissect each capture is compared with
+# the baseline stored in timing-baseline.json.
+#
+# Every frame of the captures is also dissected cut at each byte offset,
+# which must neither raise an exception nor find items beyond the captured
+# bytes, and must report incomplete and truncated telegrams.
+# ft12-truncation.c does the same for the FT 1.2 code the tools share.
+#
+# The tests are skipped (exit status 77) when tshark or the BAOS plugin
+# is not available, e.g. set WIRESHARK_PLUGIN_DIR to the build output.
+#
+# Wireshark - Network traffic analyzer
+# By Gerald Combs <gerald@wireshark.org>
+# Copyright 1998 Gerald Combs
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+
+import argparse
+import difflib
+import importlib.util
+import json
+import os
+import shutil
+import statistics
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+CAPTURE_DIR = os.path.join(TEST_DIR, 'captures')
+GOLDEN_DIR = os.path.join(TEST_DIR, 'golden')
+BASELINE_PATH = os.path.join(TEST_DIR, 'timing-baseline.json')
+GENERATOR_PATH = os.path.join(TEST_DIR, '..', 'tools', 'baos-capture-gen.py')
+
+# Exit status of skipped tests, as understood by automake and ctest (SKIP_RETURN_CODE)
+EXIT_SKIP = 77
+
+# Small devices keep the captures and golden files readable
+COMMON_ARGS = ['--datapoints', '8', '--param-bytes', '32', '--burst-rate', '0', '--error-rate', '0']
+
+# Generator arguments of the captures, one kind of traffic each.
+# The startup sequence (server items, datapoint descriptions and
+# description strings) is part of every capture.
+CAPTURES = {
+    'startup':          ['--seed', '1', '--telegrams', '1'],
+    'dp-values':        ['--seed', '2', '--telegrams', '40', '--scenario', 'poll-datapoints'],
+    'dp-writes':        ['--seed', '3', '--telegrams', '40', '--scenario', 'write-datapoints'],
+    'dp-indications':   ['--seed', '4', '--telegrams', '30', '--scenario', 'indicate-datapoints'],
+    'param-bytes':      ['--seed', '5', '--telegrams', '30', '--scenario', 'read-parameter-bytes',
+                         '--scenario', 'write-parameter-bytes'],
+    'server-items':     ['--seed', '6', '--telegrams', '30', '--scenario', 'read-server-items',
+                         '--scenario', 'indicate-server-items', '--scenario', 'write-server-items'],
+    'errors':           ['--seed', '7', '--telegrams', '60', '--error-rate', '0.3'],
+}
+
+# Fields compared with the golden files. Fields shown as strings, booleans
+# or times are left out, since their format depends on the tshark version.
+FIELDS = [
+    'frame.number',
+    'baos.subservice',
+    'baos.error_code',
+    'baos.request_in',
+    'baos.response_in',
+    'baos.start_server_item_id',
+    'baos.nr_of_server_items',
+    'baos.server_item_id',
+    'baos.server_item_length',
+    'baos.start_dp_id',
+    'baos.nr_of_dps',
+    'baos.dp_id',
+    'baos.dp_length',
+    'baos.start_desc_string',
+    'baos.nr_of_desc_strings',
+    'baos.desc_string_len',
+    'baos.start_param_byte',
+    'baos.nr_of_param_bytes',
+    'baos.param_byte',
+    'baos.dp_write.req_in',
+    'baos.dp_write.res_in',
+    'baos.dp_write.ind_in',
+    'baos.poll.changed_dps',
+    'baos.poll.unchanged_dps',
+    'baos.buffer_size',
+]
+
+# Subservices carrying a list of items, which are reported as truncated
+# if the telegram ends before the last item does
+ITEM_SUBSERVICES = {0x02, 0x06, 0x81, 0x83, 0x84, 0x85, 0xC1, 0xC2}
+# Index of the first item in an FT 1.2 frame: header, main service,
+# subservice, start and number of items
+ITEMS_INDEX = 11
+# Shortest telegram taken by the heuristic
+MIN_TELEGRAM_LENGTH = 10
+# Fields added once per item, even for the item a telegram ends in,
+# with their size. An item is only looked at if its field was captured.
+ITEM_FIELDS = {
+    'baos.dp_id': 2,
+    'baos.server_item_id': 2,
+    'baos.desc_string_len': 2,
+    'baos.param_byte': 1,
+}
+# Problems reported per capture before the rest is only counted
+MAX_REPORTED_PROBLEMS = 10
+
+USB_HEADER_LENGTH = 64
+PCAPNG_EPB = 0x00000006
+
+# Dissections of a capture in the timing test, the median is taken
+TIMING_RUNS = 5
+
+
+def load_generator():
+    spec = importlib.util.spec_from_file_location('baos_capture_gen', GENERATOR_PATH)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def generate_capture(path, args):
+    subprocess.run([sys.executable, GENERATOR_PATH, *args, path],
+                   check=True, stderr=subprocess.DEVNULL)
+
+
+class Tshark:
+    def __init__(self, path):
+        self.path = path
+
+    def run(self, capture, *args):
+        result = subprocess.run([self.path, '-n', '-r', capture, *args],
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+        if result.returncode != 0:
+            raise RuntimeError(f'tshark failed on {capture}: {result.stderr.strip()}')
+        return result.stdout
+
+    def fields(self, capture, fields, display_filter=None):
+        args = ['-2', '-T', 'fields', '-E', 'occurrence=a', '-E', 'aggregator=,']
+        if display_filter:
+            args += ['-Y', display_filter]
+        for field in fields:
+            args += ['-e', field]
+        return self.run(capture, *args)
+
+    def version(self):
+        result = subprocess.run([self.path, '-v'], stdout=subprocess.PIPE, text=True)
+        return result.stdout.splitlines()[0] if result.stdout else ''
+
+    def has_protocol(self, name):
+        result = subprocess.run([self.path, '-G', 'protocols'], stdout=subprocess.PIPE, text=True)
+        return any(line.split('\t')[2:3] == [name] for line in result.stdout.splitlines())
+
+    def time(self, capture):
+        '''Median time of a few two pass dissections'''
+        times = []
+        for _ in range(TIMING_RUNS):
+            started = time.monotonic()
+            self.fields(capture, ['baos.subservice', 'baos.response_in'])
+            times.append(time.monotonic() - started)
+        return statistics.median(times)
+
+
+def test_golden(tshark, name, update):
+    capture = os.path.join(CAPTURE_DIR, f'baos-{name}.pcapng')
+    golden = os.path.join(GOLDEN_DIR, f'baos-{name}.txt')
+    output = tshark.fields(capture, FIELDS)
+
+    if update:
+        with open(golden, 'w', encoding='utf-8') as file:
+            file.write(output)
+        return True, 'updated'
+
+    with open(golden, encoding='utf-8') as file:
+        expected = file.read()
+    if output == expected:
+        return True, ''
+    diff = difflib.unified_diff(expected.splitlines(), output.splitlines(),
+                                f'golden/baos-{name}.txt', 'tshark', lineterm='')
+    return False, '\n'.join(list(diff)[:40])
+
+
+def read_usb_records(path):
+    '''Yields the timestamp, usbmon header and data of the records of a generated capture'''
+    with open(path, 'rb') as file:
+        data = file.read()
+    offset = 0
+    while offset + 12 <= len(data):
+        block_type, block_length = struct.unpack_from('<II', data, offset)
+        if block_type == PCAPNG_EPB:
+            ts_high, ts_low, caplen = struct.unpack_from('<III', data, offset + 12)
+            record = data[offset + 28:offset + 28 + caplen]
+            yield (ts_high << 32) | ts_low, record[:USB_HEADER_LENGTH], record[USB_HEADER_LENGTH:]
+        offset += block_length
+
+
+def write_truncated_capture(source, path):
+    '''Writes a copy of every frame of the source cut at each byte offset, like a
+    short USB transfer. Returns the frame and the number of bytes left per record.'''
+    cuts = []
+    with open(path, 'wb') as file:
+        writer = load_generator().PcapngWriter(file)
+        for ts_usec, header, frame in read_usb_records(source):
+            for cut in range(1, len(frame)):
+                # URB length and data length
+                header = header[:32] + struct.pack('<II', cut, cut) + header[40:]
+                writer.write_packet(ts_usec, header + frame[:cut])
+                cuts.append((frame, cut))
+        writer.flush()
+    return cuts
+
+
+def test_truncation(tshark, name, work_dir):
+    '''Checks that truncated telegrams are dissected without exceptions,
+    with consistent expert info and without items beyond the captured bytes'''
+    path = os.path.join(work_dir, f'baos-{name}-truncated.pcapng')
+    cuts = write_truncated_capture(os.path.join(CAPTURE_DIR, f'baos-{name}.pcapng'), path)
+
+    def frames(display_filter):
+        return {int(number) for number in tshark.fields(path, ['frame.number'], display_filter).split()}
+
+    malformed = frames('_ws.malformed')
+    incomplete = frames('baos.ft12_incomplete')
+    truncated = frames('baos.truncated')
+    item_bytes = {}
+    for line in tshark.fields(path, ['frame.number', *ITEM_FIELDS], 'baos').splitlines():
+        number, *values = line.split('\t')
+        item_bytes[int(number)] = sum(size * len(value.split(',')) for size, value in
+                                      zip(ITEM_FIELDS.values(), values) if value)
+
+    problems = []
+    for number, (frame, cut) in enumerate(cuts, 1):
+        where = f'frame {number} ({len(frame)} bytes) cut at {cut}'
+        if number in malformed:
+            problems.append(f'{where}: malformed')
+        if (number in item_bytes) != (cut >= MIN_TELEGRAM_LENGTH):
+            problems.append(f'{where}: {"taken" if number in item_bytes else "not taken"} by the heuristic')
+        if number not in item_bytes:
+            continue
+        if number not in incomplete:
+            problems.append(f'{where}: no incomplete frame expert info')
+        nr_of_items = int.from_bytes(frame[ITEMS_INDEX - 2:ITEMS_INDEX], 'big')
+        is_truncated = (frame[6] in ITEM_SUBSERVICES and nr_of_items and
+                        ITEMS_INDEX <= cut < len(frame) - 2)
+        if (number in truncated) != bool(is_truncated):
+            problems.append(f'{where}: truncation expert info {"added" if number in truncated else "missing"}')
+        if item_bytes[number] > max(0, cut - ITEMS_INDEX):
+            problems.append(f'{where}: more items found than bytes captured ({item_bytes[number]} bytes)')
+
+    details = f'{len(cuts)} cuts'
+    if problems:
+        details += f', {len(problems)} problems\n' + '\n'.join(problems[:MAX_REPORTED_PROBLEMS])
+    return not problems, details
+
+
+def load_baseline():
+    '''Returns the baseline times per capture, or None if there is no baseline'''
+    if not os.path.exists(BASELINE_PATH):
+        return None
+    with open(BASELINE_PATH, encoding='utf-8') as file:
+        return json.load(file)
+
+
+def save_baseline(baseline):
+    with open(BASELINE_PATH, 'w', encoding='utf-8') as file:
+        json.dump(baseline, file, indent=4)
+        file.write('\n')
+
+
+def measure_empty(tshark, work_dir):
+    '''Time tshark takes to start up and read an empty capture'''
+    empty_capture = os.path.join(work_dir, 'empty.pcapng')
+    with open(empty_capture, 'wb') as file:
+        load_generator().PcapngWriter(file).flush()
+    return tshark.time(empty_capture)
+
+
+def test_timing(tshark, name, startup, baseline, tolerance, slack, update):
+    '''Compares the dissection time of a capture without the startup of tshark with the baseline'''
+    elapsed = max(0.0, tshark.time(os.path.join(CAPTURE_DIR, f'baos-{name}.pcapng')) - startup)
+    measured = f'{elapsed:.3f} s'
+
+    if update:
+        baseline['captures'][name] = round(elapsed, 3)
+        return True, f'{measured}, baseline recorded'
+
+    if name not in baseline['captures']:
+        return False, f'{measured}, no baseline (record one with --update-baseline)'
+
+    seconds = baseline['captures'][name]
+    limit = seconds * (1.0 + tolerance) + slack
+    details = f'{measured}, baseline {seconds:.3f} s, limit {limit:.3f} s'
+    if baseline.get('tshark') != tshark.version():
+        details += f' (baseline taken with {baseline.get("tshark")})'
+    return elapsed <= limit, details
+
+
+def regenerate_captures():
+    os.makedirs(CAPTURE_DIR, exist_ok=True)
+    for name, args in CAPTURES.items():
+        generate_capture(os.path.join(CAPTURE_DIR, f'baos-{name}.pcapng'), COMMON_ARGS + args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Regression tests of the BAOS dissector using tshark.')
+    parser.add_argument('tests', nargs='*', metavar='capture',
+                        help=f'captures to compare ({", ".join(CAPTURES)}, default: all)')
+    parser.add_argument('--tshark', default=os.environ.get('TSHARK', 'tshark'),
+                        help='tshark binary (default: $TSHARK or tshark in the PATH)')
+    parser.add_argument('--update', action='store_true',
+                        help='write the output of tshark to the golden files instead of comparing')
+    parser.add_argument('--regenerate', action='store_true',
+                        help='rebuild the captures with the generator, e.g. after protocol changes')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the measured dissection times as the new baseline')
+    parser.add_argument('--tolerance', type=float, default=0.25,
+                        help='allowed slowdown relative to the baseline (default: 0.25)')
+    parser.add_argument('--slack', type=float, default=0.2,
+                        help='allowed slowdown in seconds on top, for noisy machines (default: 0.2)')
+    parser.add_argument('--no-timing', action='store_true', help='skip the timing test')
+    parser.add_argument('--no-truncation', action='store_true',
+                        help='skip dissecting the captures cut at every byte of every frame')
+    args = parser.parse_args()
+    for name in args.tests:
+        if name not in CAPTURES:
+            parser.error(f'unknown capture: {name}')
+
+    if args.regenerate:
+        regenerate_captures()
+
+    tshark_path = shutil.which(args.tshark)
+    if not tshark_path:
+        print(f'SKIP: {args.tshark} not found')
+        return EXIT_SKIP
+    tshark = Tshark(tshark_path)
+    if not tshark.has_protocol('baos'):
+        print(f'SKIP: the BAOS plugin is not loaded by {tshark_path}')
+        return EXIT_SKIP
+
+    failures = 0
+
+    def report(test, passed, details):
+        nonlocal failures
+        failures += not passed
+        print(f'{"ok  " if passed else "FAIL"} {test}' + (f': {details}' if details and '\n' not in details else ''))
+        if '\n' in details:
+            print(details)
+
+    for name in args.tests or CAPTURES:
+        report(f'golden {name}', *test_golden(tshark, name, args.update))
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        for name in (args.tests or CAPTURES) if not args.no_truncation else ():
+            report(f'truncation {name}', *test_truncation(tshark, name, work_dir))
+
+        if not args.no_timing:
+            baseline = load_baseline()
+            if baseline is None and not args.update_baseline:
+                report('timing', False, f'{BASELINE_PATH} is missing (record it with --update-baseline)')
+            else:
+                if args.update_baseline:
+                    baseline = {'tshark': tshark.version(), 'captures': (baseline or {}).get('captures', {})}
+                startup = measure_empty(tshark, work_dir)
+                for name in args.tests or CAPTURES:
+                    report(f'timing {name}', *test_timing(tshark, name, startup, baseline,
+                                                          args.tolerance, args.slack, args.update_baseline))
+                if args.update_baseline:
+                    save_baseline(baseline)
+
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
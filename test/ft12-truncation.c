@@ -0,0 +1,309 @@
+/* ft12-truncation.c
+ *
+ * Truncation test of the FT 1.2 parsing code shared by the BAOS plugin
+ * and the standalone tools (plugins/epan/baos/ft12.c)
+ * By Adam Rigely <adamrigely@pm.me>
+ *
+ * Takes the FT 1.2 frames of pcapng captures made by
+ * tools/baos-capture-gen.py, cuts each of them at every byte offset into
+ * a buffer of exactly that size and checks that the parsing functions and
+ * the scanner agree on what is left of the frame. Build it with the
+ * sanitizers, so that reads beyond a buffer fail the test:
+ *
+ *   cc -g -fsanitize=address,undefined -I../plugins/epan/baos -o ft12-truncation \
+ *      ft12-truncation.c ../plugins/epan/baos/ft12.c
+ *   ./ft12-truncation captures/baos-*.pcapng
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ */
+
+// Imports
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ft12.h"
+
+#define LINKTYPE_USB_LINUX_MMAPPED 220
+#define USB_LINUX_MMAPPED_HEADER_LENGTH 64
+
+// pcapng block types, read as little endian
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+
+// Bytes of the FT 1.2 header and the BAOS payload up to the number of items
+#define BAOS_ITEMS_INDEX (FT12_HEADER_LENGTH + 6)
+
+// Failures reported before the rest is only counted
+#define MAX_REPORTED_FAILURES 20
+
+typedef struct _test_state_t
+{
+	const char *path;
+	uint64_t frame_number;
+	size_t frame_length;
+	size_t cut;
+	uint64_t nr_of_cuts;
+	uint64_t nr_of_failures;
+} test_state_t;
+
+static void
+fail(test_state_t *state, const char *check)
+{
+	if (state->nr_of_failures++ < MAX_REPORTED_FAILURES)
+		fprintf(stderr, "%s: frame %" PRIu64 " (%zu bytes) cut at %zu: %s\n",
+				state->path, state->frame_number, state->frame_length, state->cut, check);
+}
+
+#define CHECK(state, condition) \
+	do \
+	{ \
+		if (!(condition)) \
+			fail((state), #condition); \
+	} while (0)
+
+static uint32_t
+read_le32(const uint8_t *bytes)
+{
+	return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+// Scans a buffer holding the whole stream.
+// Returns the number of variable length frames found,
+// and the offset and length of the last one.
+static unsigned
+scan_stream(const uint8_t *bytes, size_t length, uint64_t *offset, uint16_t *frame_length)
+{
+	ft12_scanner_t scanner;
+	ft12_scan_result_t frame;
+	unsigned nr_of_frames = 0;
+
+	ft12_scanner_init(&scanner);
+	ft12_scanner_finish(&scanner);
+	while (ft12_scanner_next(&scanner, &bytes, &length, &frame))
+	{
+		if (frame.type != FT12_VARIABLE_FRAME)
+			continue;
+		nr_of_frames++;
+		*offset = frame.offset;
+		*frame_length = frame.length;
+	}
+	return nr_of_frames;
+}
+
+// Hands the stream to the scanner in two inputs, split at the cut.
+// Returns the number of variable length frames found.
+static unsigned
+scan_split_stream(const uint8_t *bytes, size_t length, size_t split, uint16_t *frame_length)
+{
+	ft12_scanner_t scanner;
+	ft12_scan_result_t frame;
+	unsigned nr_of_frames = 0;
+	const uint8_t *input = bytes;
+	size_t remaining = split;
+
+	ft12_scanner_init(&scanner);
+	for (int i = 0; i < 2; i++)
+	{
+		if (i)
+		{
+			input = bytes + split;
+			remaining = length - split;
+			ft12_scanner_finish(&scanner);
+		}
+		while (ft12_scanner_next(&scanner, &input, &remaining, &frame))
+		{
+			if (frame.type != FT12_VARIABLE_FRAME)
+				continue;
+			nr_of_frames++;
+			*frame_length = frame.length;
+		}
+	}
+	return nr_of_frames;
+}
+
+// Checks a frame cut after the given number of bytes,
+// against what is known about the whole frame
+static void
+test_cut(test_state_t *state, const uint8_t *frame_bytes, size_t cut, const ft12_frame_t *whole_frame,
+			bool has_response_code, uint8_t whole_response_code)
+{
+	const size_t frame_length = state->frame_length;
+
+	// Exactly the bytes left, so that the sanitizers catch reads beyond them
+	uint8_t *bytes = malloc(cut ? cut : 1);
+	if (!bytes)
+	{
+		perror("malloc");
+		exit(2);
+	}
+	memcpy(bytes, frame_bytes, cut);
+	state->cut = cut;
+	state->nr_of_cuts++;
+
+	// The pattern needs the start byte, length byte twice, start byte,
+	// control byte and main service
+	const bool has_pattern = cut >= FT12_HEADER_LENGTH + 1;
+	CHECK(state, ft12_find_baos_pattern(bytes, cut) == (has_pattern ? 0 : UINT8_MAX));
+	CHECK(state, ft12_is_baos_pattern_at(bytes, cut, 0) == has_pattern);
+
+	// A frame is parsed as soon as the subservice is there
+	ft12_frame_t frame;
+	const bool is_parsed = ft12_parse_baos_frame(bytes, cut, &frame);
+	CHECK(state, is_parsed == (cut >= FT12_HEADER_LENGTH + 2));
+	if (is_parsed)
+	{
+		CHECK(state, frame.start_byte_index == 0);
+		CHECK(state, frame.subservice == whole_frame->subservice);
+		CHECK(state, frame.trailer_start_index == whole_frame->trailer_start_index);
+		CHECK(state, frame.is_complete == (cut == frame_length));
+		CHECK(state, frame.is_checksum_known == (cut > frame.trailer_start_index));
+		CHECK(state, !frame.is_checksum_known || frame.is_checksum_ok);
+
+		// The response code is the byte after the number of items
+		uint8_t response_code = 0;
+		const bool has_cut_response_code = ft12_get_baos_response_code(bytes, cut, &frame, &response_code);
+		CHECK(state, has_cut_response_code == (has_response_code && cut > BAOS_ITEMS_INDEX));
+		CHECK(state, !has_cut_response_code || response_code == whole_response_code);
+	}
+
+	// The start of a frame is neither an acknowledgement nor a fixed length frame
+	CHECK(state, ft12_get_short_frame_type(bytes, cut) == UINT8_MAX);
+
+	// The frame is only found once it's complete
+	uint64_t offset = UINT64_MAX;
+	uint16_t scanned_length = 0;
+	const unsigned nr_of_frames = scan_stream(bytes, cut, &offset, &scanned_length);
+	CHECK(state, nr_of_frames == (cut == frame_length ? 1u : 0u));
+	CHECK(state, nr_of_frames == 0 || (offset == 0 && scanned_length == frame_length));
+
+	// Frames spanning two inputs are found like frames in a single input
+	scanned_length = 0;
+	CHECK(state, scan_split_stream(frame_bytes, frame_length, cut, &scanned_length) == 1);
+	CHECK(state, scanned_length == frame_length);
+
+	free(bytes);
+}
+
+static void
+test_frame(test_state_t *state, const uint8_t *bytes, size_t length)
+{
+	ft12_frame_t whole_frame;
+
+	state->frame_number++;
+	state->frame_length = length;
+	state->cut = length;
+
+	// The generator only writes complete and valid frames
+	if (!ft12_parse_baos_frame(bytes, length, &whole_frame) || whole_frame.start_byte_index != 0 ||
+		!whole_frame.is_complete || !whole_frame.is_checksum_ok ||
+		whole_frame.trailer_start_index + (size_t)FT12_TRAILER_LENGTH != length)
+	{
+		fail(state, "not a complete FT 1.2 frame carrying BAOS");
+		return;
+	}
+
+	uint8_t whole_response_code = 0;
+	const bool has_response_code = ft12_get_baos_response_code(bytes, length, &whole_frame, &whole_response_code);
+
+	for (size_t cut = 0; cut <= length; cut++)
+		test_cut(state, bytes, cut, &whole_frame, has_response_code, whole_response_code);
+}
+
+// Reads a little endian pcapng file with a single USB interface.
+// Returns false if it can't be read.
+static bool
+test_capture(test_state_t *state)
+{
+	FILE *file = fopen(state->path, "rb");
+	if (!file)
+	{
+		perror(state->path);
+		return false;
+	}
+
+	uint8_t *block = NULL;
+	uint8_t header[8];
+	bool is_ok = true;
+	while (is_ok && fread(header, 1, sizeof(header), file) == sizeof(header))
+	{
+		const uint32_t block_type = read_le32(header);
+		const uint32_t block_length = read_le32(header + 4);
+		if (block_length < 12 || block_length % 4)
+		{
+			fprintf(stderr, "%s: bad block length %" PRIu32 "\n", state->path, block_length);
+			is_ok = false;
+			break;
+		}
+
+		uint8_t *body = realloc(block, block_length - 8);
+		if (!body || fread(body, 1, block_length - 8, file) != block_length - 8)
+		{
+			fprintf(stderr, "%s: truncated block\n", state->path);
+			block = body ? body : block;
+			is_ok = false;
+			break;
+		}
+		block = body;
+
+		if (block_type == PCAPNG_SHB && read_le32(body) != PCAPNG_BYTE_ORDER_MAGIC)
+		{
+			fprintf(stderr, "%s: only little endian captures are supported\n", state->path);
+			is_ok = false;
+		}
+		else if (block_type == PCAPNG_IDB && (body[0] | body[1] << 8) != LINKTYPE_USB_LINUX_MMAPPED)
+		{
+			fprintf(stderr, "%s: not a capture of tools/baos-capture-gen.py\n", state->path);
+			is_ok = false;
+		}
+		else if (block_type == PCAPNG_EPB)
+		{
+			const uint32_t caplen = read_le32(body + 12);
+			if (caplen > block_length - 32 || caplen < USB_LINUX_MMAPPED_HEADER_LENGTH)
+			{
+				fprintf(stderr, "%s: bad record length %" PRIu32 "\n", state->path, caplen);
+				is_ok = false;
+			}
+			else if (caplen > USB_LINUX_MMAPPED_HEADER_LENGTH)
+			{
+				test_frame(state, body + 20 + USB_LINUX_MMAPPED_HEADER_LENGTH, caplen - USB_LINUX_MMAPPED_HEADER_LENGTH);
+			}
+		}
+	}
+
+	free(block);
+	fclose(file);
+	return is_ok;
+}
+
+int
+main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: ft12-truncation capture...\n");
+		return 2;
+	}
+
+	uint64_t nr_of_failures = 0;
+	bool is_ok = true;
+	for (int i = 1; i < argc; i++)
+	{
+		test_state_t state = { .path = argv[i] };
+
+		is_ok = test_capture(&state) && is_ok;
+		printf("%s %s: %" PRIu64 " frames, %" PRIu64 " cuts, %" PRIu64 " failures\n",
+				state.nr_of_failures ? "FAIL" : "ok  ", state.path,
+				state.frame_number, state.nr_of_cuts, state.nr_of_failures);
+		nr_of_failures += state.nr_of_failures;
+	}
+	return is_ok && !nr_of_failures ? 0 : 1;
+}
@@ -0,0 +1,1140 @@
+/* baos-analyzer.c
+ *
+ * Standalone analyzer for captures of serial BAOS traffic
+ * By Adam Rigely <adamrigely@pm.me>
+ *
+ * Memory-maps a pcap or pcapng file, parses the FT 1.2 frames of its
+ * records on a pool of threads with the same code the BAOS plugin uses
+ * (plugins/epan/baos/ft12.c) and prints subservice counts, error rates
+ * and round trip times. Meant for captures too large to be opened in
+ * Wireshark in reasonable time. Raw dumps of a serial line, without any
+ * capture file format, are scanned for frames from start to end.
+ * Build it with:
+ *
+ *   cc -O2 -pthread -I../plugins/epan/baos -o baos-analyzer \
+ *      baos-analyzer.c ../plugins/epan/baos/ft12.c
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ */
+
+#define _DEFAULT_SOURCE
+
+// Imports
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ft12.h"
+
+// Link-layer types serial BAOS is captured with
+#define LINKTYPE_USB_LINUX 189
+#define LINKTYPE_USB_LINUX_MMAPPED 220
+#define LINKTYPE_WIRESHARK_UPPER_PDU 252
+
+#define USB_LINUX_HEADER_LENGTH 48
+#define USB_LINUX_MMAPPED_HEADER_LENGTH 64
+
+// pcap magic numbers, read as little endian
+#define PCAP_MAGIC_USEC 0xA1B2C3D4
+#define PCAP_MAGIC_USEC_SWAPPED 0xD4C3B2A1
+#define PCAP_MAGIC_NSEC 0xA1B23C4D
+#define PCAP_MAGIC_NSEC_SWAPPED 0x4D3CB2A1
+#define PCAP_HEADER_LENGTH 24
+#define PCAP_RECORD_HEADER_LENGTH 16
+
+// pcapng block types and byte order magic, read as little endian
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_BYTE_ORDER_MAGIC_SWAPPED 0x4D3C2B1A
+#define PCAPNG_OPT_IF_TSRESOL 9
+
+#define NSEC_PER_SEC UINT64_C(1000000000)
+
+#define DEFAULT_CHUNK_SIZE 4096
+#define MAX_REPORTED_RESYNCS 10
+#define MAX_THREADS 256
+
+// Round trip times are sorted into 8 buckets per power of 2,
+// which keeps percentiles within 12.5 % of the exact value
+#define RTT_SUB_BUCKETS 8
+#define RTT_BUCKETS (RTT_SUB_BUCKETS + 61 * RTT_SUB_BUCKETS)
+
+// Requests and responses are told apart by the
+// highest bit of the subservice, and their RTTs
+// are accounted by the lowest 4 bits
+#define BAOS_RESPONSE_FLAG 0x80
+#define NR_OF_REQUESTS 16
+
+// Record of the capture file, found by indexing
+// the file before the records are analyzed
+typedef struct _capture_record_t
+{
+	uint64_t offset;                // Offset of the packet data in the file
+	uint64_t ts;                    // Nanoseconds
+	uint32_t caplen;
+	uint16_t linktype;
+	bool is_big_endian;             // Byte order of the file, usbmon headers follow it
+} capture_record_t;
+
+typedef struct _capture_t
+{
+	const uint8_t *data;
+	size_t size;
+	const char *format;
+	capture_record_t *records;
+	size_t nr_of_records;
+	size_t capacity;
+	uint64_t skipped_blocks;        // pcapng blocks without a timestamped packet
+	bool is_raw;                    // Raw serial byte stream, without records
+} capture_t;
+
+// pcapng interface, as described by an IDB
+typedef struct _capture_interface_t
+{
+	uint16_t linktype;
+	uint64_t units_per_sec;
+} capture_interface_t;
+
+typedef struct _rtt_stats_t
+{
+	uint64_t count;
+	uint64_t sum;
+	uint64_t min;
+	uint64_t max;
+	uint64_t unmatched;             // Responses without a preceding request
+	uint64_t buckets[RTT_BUCKETS];
+} rtt_stats_t;
+
+// Statistics of a worker thread, merged once all chunks are done
+typedef struct _baos_stats_t
+{
+	uint64_t records;
+	uint64_t bytes;                 // Captured bytes of all records
+	uint64_t ft12_frames;
+	uint64_t checksum_errors;
+	uint64_t incomplete_frames;
+	uint64_t acks;                  // FT 1.2 single character acknowledgements
+	uint64_t fixed_frames;          // FT 1.2 fixed length frames, e.g. link resets
+	uint64_t subservices[256];
+	uint64_t response_codes[256];   // Object server response codes of responses carrying one
+	uint64_t resyncs;               // Frames found after bytes not belonging to any frame
+	uint64_t skipped_bytes;
+	uint64_t resync_offsets[MAX_REPORTED_RESYNCS];  // First resyncs of raw streams
+	rtt_stats_t rtt[NR_OF_REQUESTS];
+} baos_stats_t;
+
+// Requests and responses of one subservice of one device.
+// A chunk can't know the request left pending by the chunks
+// before, so it keeps the response it can't match on its own
+// and the request it leaves pending for the chunks after.
+typedef struct _rtt_link_t
+{
+	uint64_t key;                   // Device in the upper bits, request subservice in the lowest byte
+	uint64_t first_response_ts;
+	uint64_t pending_request_ts;
+	bool is_used;
+	bool has_request;               // Request found before the first response
+	bool has_first_response;
+	bool has_pending_request;
+} rtt_link_t;
+
+// Open addressing hash table of RTT links
+typedef struct _rtt_link_table_t
+{
+	rtt_link_t *links;
+	size_t capacity;                // Power of 2
+	size_t count;
+} rtt_link_table_t;
+
+typedef struct _analyzer_t
+{
+	const capture_t *capture;
+	size_t chunk_size;              // Records per chunk
+	size_t nr_of_chunks;
+	rtt_link_table_t *chunk_links;  // One table per chunk, merged in capture order
+	atomic_size_t next_chunk;
+} analyzer_t;
+
+typedef struct _worker_t
+{
+	analyzer_t *analyzer;
+	pthread_t thread;
+	baos_stats_t stats;
+} worker_t;
+
+typedef struct _name_t
+{
+	uint8_t code;
+	const char *name;
+} name_t;
+
+static const name_t subservice_names[] = {
+	{GET_SERVER_ITEM_REQ_CODE, "GetServerItem.Req"},
+	{SET_SERVER_ITEM_REQ_CODE, "SetServerItem.Req"},
+	{GET_DATAPOINT_DESC_REQ_CODE, "GetDatapointDescription.Req"},
+	{GET_DESC_STRING_REQ_CODE, "GetDescriptionString.Req"},
+	{GET_DATAPOINT_VALUE_REQ_CODE, "GetDatapointValue.Req"},
+	{SET_DATAPOINT_VALUE_REQ_CODE, "SetDatapointValue.Req"},
+	{GET_PARAMETER_BYTE_REQ_CODE, "GetParameterByte.Req"},
+	{SET_PARAMETER_BYTE_REQ_CODE, "SetParameterByte.Req"},
+	{GET_SERVER_ITEM_RES_CODE, "GetServerItem.Res"},
+	{SET_SERVER_ITEM_RES_CODE, "SetServerItem.Res"},
+	{GET_DATAPOINT_DESC_RES_CODE, "GetDatapointDescription.Res"},
+	{GET_DESC_STRING_RES_CODE, "GetDescriptionString.Res"},
+	{GET_DATAPOINT_VALUE_RES_CODE, "GetDatapointValue.Res"},
+	{SET_DATAPOINT_VALUE_RES_CODE, "SetDatapointValue.Res"},
+	{GET_PARAMETER_BYTE_RES_CODE, "GetParameterByte.Res"},
+	{SET_PARAMETER_BYTE_RES_CODE, "SetParameterByte.Res"},
+	{DATAPOINT_VALUE_IND_CODE, "DatapointValue.Ind"},
+	{SERVER_ITEM_IND_CODE, "ServerItem.Ind"},
+	{0, NULL}
+};
+
+// Refer to Appendix B in the BAOS documentation
+// to find out more about the available error codes.
+static const name_t response_code_names[] = {
+	{SUCCESS, "Success"},
+	{INTERNAL_ERROR, "Internal error"},
+	{NO_ELEMENT_FOUND, "No element found"},
+	{BUFFER_TOO_SMALL, "Buffer is too small"},
+	{ITEM_NOT_WRITABLE, "Item is not writable"},
+	{SERVICE_NOT_SUPPORTED, "Service is not supported"},
+	{BAD_SERVICE_PARAMETER, "Bad service parameter"},
+	{BAD_ID, "Bad ID"},
+	{BAD_COMMAND_VALUE, "Bad command / value"},
+	{BAD_LENGTH, "Bad length"},
+	{MESSAGE_INCONSISTENT, "Message inconsistent"},
+	{OBJECT_SERVER_BUSY, "Object server is busy"},
+	{0, NULL}
+};
+
+// Looks up the name of a code.
+// Returns "Unknown" if the code has no name.
+static const char *
+get_name(const name_t *names, uint8_t code)
+{
+	for (; names->name; names++)
+	{
+		if (names->code == code)
+			return names->name;
+	}
+	return "Unknown";
+}
+
+static uint16_t
+read_u16(const uint8_t *bytes, bool is_big_endian)
+{
+	return is_big_endian ?
+			(uint16_t)(bytes[0] << 8 | bytes[1]) :
+			(uint16_t)(bytes[1] << 8 | bytes[0]);
+}
+
+static uint32_t
+read_u32(const uint8_t *bytes, bool is_big_endian)
+{
+	return is_big_endian ?
+			(uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3] :
+			(uint32_t)bytes[3] << 24 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[1] << 8 | bytes[0];
+}
+
+static double
+get_seconds(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Converts a timestamp in the given units to nanoseconds
+static uint64_t
+get_ts_nsec(uint64_t ts, uint64_t units_per_sec)
+{
+	if (units_per_sec == NSEC_PER_SEC)
+		return ts;
+
+	return ts / units_per_sec * NSEC_PER_SEC +
+			(uint64_t)((double)(ts % units_per_sec) * 1e9 / (double)units_per_sec);
+}
+
+// Appends a record to the index of the capture.
+// Returns false if there is no memory left.
+static bool
+add_capture_record(capture_t *capture, uint64_t offset, uint32_t caplen, uint64_t ts, uint16_t linktype, bool is_big_endian)
+{
+	if (capture->nr_of_records == capture->capacity)
+	{
+		const size_t capacity = capture->capacity ? capture->capacity * 2 : 65536;
+		capture_record_t *records = realloc(capture->records, capacity * sizeof(capture_record_t));
+		if (!records)
+			return false;
+
+		capture->records = records;
+		capture->capacity = capacity;
+	}
+
+	capture_record_t *record = &capture->records[capture->nr_of_records++];
+	record->offset = offset;
+	record->caplen = caplen;
+	record->ts = ts;
+	record->linktype = linktype;
+	record->is_big_endian = is_big_endian;
+	return true;
+}
+
+// Indexes the records of a pcap file.
+// Returns false if the file is broken.
+static bool
+index_pcap(capture_t *capture, uint32_t magic)
+{
+	const bool is_big_endian = magic == PCAP_MAGIC_USEC_SWAPPED || magic == PCAP_MAGIC_NSEC_SWAPPED;
+	const bool is_nsec = magic == PCAP_MAGIC_NSEC || magic == PCAP_MAGIC_NSEC_SWAPPED;
+
+	if (capture->size < PCAP_HEADER_LENGTH)
+	{
+		fprintf(stderr, "baos-analyzer: pcap file header is truncated\n");
+		return false;
+	}
+	capture->format = is_nsec ? "pcap (nanoseconds)" : "pcap";
+
+	// The upper bits of the link-layer type field hold FCS information
+	const uint16_t linktype = (uint16_t)read_u32(capture->data + 20, is_big_endian);
+
+	size_t offset = PCAP_HEADER_LENGTH;
+	while (offset + PCAP_RECORD_HEADER_LENGTH <= capture->size)
+	{
+		const uint8_t *record = capture->data + offset;
+		const uint64_t ts_sec = read_u32(record, is_big_endian);
+		const uint64_t ts_frac = read_u32(record + 4, is_big_endian);
+		const uint32_t caplen = read_u32(record + 8, is_big_endian);
+
+		if (caplen > capture->size - offset - PCAP_RECORD_HEADER_LENGTH)
+		{
+			fprintf(stderr, "baos-analyzer: record at offset %zu is truncated, ignoring the rest of the file\n", offset);
+			break;
+		}
+
+		const uint64_t ts = ts_sec * NSEC_PER_SEC + (is_nsec ? ts_frac : ts_frac * 1000);
+		if (!add_capture_record(capture, offset + PCAP_RECORD_HEADER_LENGTH, caplen, ts, linktype, is_big_endian))
+		{
+			fprintf(stderr, "baos-analyzer: out of memory\n");
+			return false;
+		}
+		offset += PCAP_RECORD_HEADER_LENGTH + caplen;
+	}
+	return true;
+}
+
+// Reads the timestamp resolution from the options of an IDB.
+// Returns the units per second, microseconds if there is no resolution option.
+static uint64_t
+get_pcapng_if_tsresol(const uint8_t *options, size_t length, bool is_big_endian)
+{
+	size_t offset = 0;
+	while (offset + 4 <= length)
+	{
+		const uint16_t code = read_u16(options + offset, is_big_endian);
+		const uint16_t option_length = read_u16(options + offset + 2, is_big_endian);
+
+		if (!code || offset + 4 + option_length > length)
+			break;
+
+		if (code == PCAPNG_OPT_IF_TSRESOL && option_length >= 1)
+		{
+			// Highest bit set: negative power of 2, negative power of 10 otherwise
+			const uint8_t tsresol = options[offset + 4];
+			const uint8_t exponent = tsresol & 0x7F;
+
+			if (tsresol & 0x80)
+				return exponent < 64 ? UINT64_C(1) << exponent : 0;
+
+			uint64_t units_per_sec = 1;
+			for (uint8_t i = 0; i < exponent && i < 20; i++)
+				units_per_sec *= 10;
+			return exponent < 20 ? units_per_sec : 0;
+		}
+		// Options are padded to 32 bits
+		offset += 4 + (((size_t)option_length + 3) & ~(size_t)3);
+	}
+	return 1000000;
+}
+
+// Indexes the records of a pcapng file, which may hold several sections.
+// Only enhanced packet blocks are indexed, as others lack timestamps.
+// Returns false if the file is broken.
+static bool
+index_pcapng(capture_t *capture)
+{
+	capture_interface_t *interfaces = NULL;
+	size_t nr_of_interfaces = 0;
+	bool is_big_endian = false;
+	bool is_ok = true;
+
+	capture->format = "pcapng";
+
+	size_t offset = 0;
+	while (offset + 12 <= capture->size)
+	{
+		const uint8_t *block = capture->data + offset;
+		const uint32_t block_type = read_u32(block, is_big_endian);
+
+		// Byte order may change with every section
+		if (block_type == PCAPNG_SHB)
+		{
+			const uint32_t byte_order_magic = read_u32(block + 8, false);
+			if (byte_order_magic != PCAPNG_BYTE_ORDER_MAGIC && byte_order_magic != PCAPNG_BYTE_ORDER_MAGIC_SWAPPED)
+			{
+				fprintf(stderr, "baos-analyzer: bad byte order magic at offset %zu\n", offset);
+				is_ok = false;
+				break;
+			}
+			is_big_endian = byte_order_magic == PCAPNG_BYTE_ORDER_MAGIC_SWAPPED;
+			nr_of_interfaces = 0;
+		}
+
+		const uint32_t block_length = read_u32(block + 4, is_big_endian);
+		if (block_length < 12 || block_length % 4 || block_length > capture->size - offset)
+		{
+			fprintf(stderr, "baos-analyzer: block at offset %zu is truncated, ignoring the rest of the file\n", offset);
+			break;
+		}
+
+		if (block_type == PCAPNG_IDB && block_length >= 20)
+		{
+			capture_interface_t *grown = realloc(interfaces, (nr_of_interfaces + 1) * sizeof(capture_interface_t));
+			if (!grown)
+			{
+				fprintf(stderr, "baos-analyzer: out of memory\n");
+				is_ok = false;
+				break;
+			}
+			interfaces = grown;
+			interfaces[nr_of_interfaces].linktype = read_u16(block + 8, is_big_endian);
+			interfaces[nr_of_interfaces].units_per_sec = get_pcapng_if_tsresol(block + 16, block_length - 20, is_big_endian);
+			nr_of_interfaces++;
+		}
+		else if (block_type == PCAPNG_EPB && block_length >= 32)
+		{
+			const uint32_t interface_id = read_u32(block + 8, is_big_endian);
+			const uint64_t ts = (uint64_t)read_u32(block + 12, is_big_endian) << 32 | read_u32(block + 16, is_big_endian);
+			const uint32_t caplen = read_u32(block + 20, is_big_endian);
+
+			if (interface_id >= nr_of_interfaces || !interfaces[interface_id].units_per_sec ||
+				caplen > block_length - 32)
+			{
+				capture->skipped_blocks++;
+			}
+			else if (!add_capture_record(
+							capture,
+							offset + 28,
+							caplen,
+							get_ts_nsec(ts, interfaces[interface_id].units_per_sec),
+							interfaces[interface_id].linktype,
+							is_big_endian
+							))
+			{
+				fprintf(stderr, "baos-analyzer: out of memory\n");
+				is_ok = false;
+				break;
+			}
+		}
+		else if (block_type != PCAPNG_SHB && block_type != PCAPNG_IDB)
+		{
+			capture->skipped_blocks++;
+		}
+		offset += block_length;
+	}
+
+	free(interfaces);
+	return is_ok;
+}
+
+// Finds the serial data of a record and the device it has been
+// exchanged with. USB devices are told apart by bus and address,
+// exported PDUs don't carry a device.
+// Returns false if the link-layer type can't carry serial BAOS.
+static bool
+get_record_payload(const capture_t *capture, const capture_record_t *record, const uint8_t **payload, size_t *length, uint32_t *device)
+{
+	const uint8_t *data = capture->data + record->offset;
+	size_t header_length = 0;
+
+	switch (record->linktype)
+	{
+		case LINKTYPE_USB_LINUX:
+		case LINKTYPE_USB_LINUX_MMAPPED:
+			header_length = record->linktype == LINKTYPE_USB_LINUX ?
+								USB_LINUX_HEADER_LENGTH : USB_LINUX_MMAPPED_HEADER_LENGTH;
+			if (record->caplen < header_length)
+				return false;
+
+			*device = (uint32_t)read_u16(data + 12, record->is_big_endian) << 16 | data[11];
+			break;
+
+		case LINKTYPE_WIRESHARK_UPPER_PDU:
+			// Tags are big endian and end with the end of options tag
+			for (;;)
+			{
+				if (record->caplen < header_length + 4)
+					return false;
+
+				const uint16_t tag = read_u16(data + header_length, true);
+				const uint16_t tag_length = read_u16(data + header_length + 2, true);
+				header_length += 4 + tag_length;
+				if (!tag)
+					break;
+			}
+			if (record->caplen < header_length)
+				return false;
+
+			*device = 0;
+			break;
+
+		default:
+			return false;
+	}
+
+	*payload = data + header_length;
+	*length = record->caplen - header_length;
+	return true;
+}
+
+// Finds the link of a device and request subservice,
+// adding it if it's not in the table yet.
+// Returns NULL if there is no memory left.
+static rtt_link_t *
+get_rtt_link(rtt_link_table_t *table, uint64_t key)
+{
+	// Keep at least half of the table empty
+	if ((table->count + 1) * 2 > table->capacity)
+	{
+		rtt_link_table_t grown = { 0 };
+		grown.capacity = table->capacity ? table->capacity * 2 : 64;
+		grown.links = calloc(grown.capacity, sizeof(rtt_link_t));
+		if (!grown.links)
+			return NULL;
+
+		for (size_t i = 0; i < table->capacity; i++)
+		{
+			if (table->links[i].is_used)
+				*get_rtt_link(&grown, table->links[i].key) = table->links[i];
+		}
+		free(table->links);
+		*table = grown;
+	}
+
+	uint64_t hash = key * UINT64_C(0x9E3779B97F4A7C15);
+	size_t index = (size_t)(hash ^ (hash >> 32)) & (table->capacity - 1);
+	while (table->links[index].is_used && table->links[index].key != key)
+		index = (index + 1) & (table->capacity - 1);
+
+	rtt_link_t *link = &table->links[index];
+	if (!link->is_used)
+	{
+		link->is_used = true;
+		link->key = key;
+		table->count++;
+	}
+	return link;
+}
+
+// Sorts a round trip time into its histogram bucket
+static size_t
+get_rtt_bucket(uint64_t rtt)
+{
+	if (rtt < RTT_SUB_BUCKETS)
+		return (size_t)rtt;
+
+	const int exponent = 63 - __builtin_clzll(rtt);
+	const size_t sub_bucket = (size_t)(rtt >> (exponent - 3)) & (RTT_SUB_BUCKETS - 1);
+	return RTT_SUB_BUCKETS + (size_t)(exponent - 3) * RTT_SUB_BUCKETS + sub_bucket;
+}
+
+// Returns the smallest round trip time sorted into a bucket
+static uint64_t
+get_rtt_bucket_start(size_t bucket)
+{
+	if (bucket < RTT_SUB_BUCKETS)
+		return bucket;
+
+	const size_t exponent = (bucket - RTT_SUB_BUCKETS) / RTT_SUB_BUCKETS + 3;
+	const uint64_t sub_bucket = (bucket - RTT_SUB_BUCKETS) % RTT_SUB_BUCKETS;
+	return (RTT_SUB_BUCKETS + sub_bucket) << (exponent - 3);
+}
+
+static void
+add_rtt(rtt_stats_t *stats, uint64_t request_ts, uint64_t response_ts)
+{
+	// Records may be out of order
+	const uint64_t rtt = response_ts > request_ts ? response_ts - request_ts : 0;
+
+	stats->min = stats->count ? (rtt < stats->min ? rtt : stats->min) : rtt;
+	stats->max = rtt > stats->max ? rtt : stats->max;
+	stats->count++;
+	stats->sum += rtt;
+	stats->buckets[get_rtt_bucket(rtt)]++;
+}
+
+// Counts a BAOS frame found in a record or stream.
+// Returns false if it isn't a BAOS frame.
+static bool
+count_baos_frame(baos_stats_t *stats, const uint8_t *bytes, size_t length, ft12_frame_t *frame)
+{
+	if (!ft12_parse_baos_frame(bytes, length, frame))
+		return false;
+
+	stats->ft12_frames++;
+	stats->subservices[frame->subservice]++;
+	if (!frame->is_complete)
+		stats->incomplete_frames++;
+	if (frame->is_checksum_known && !frame->is_checksum_ok)
+		stats->checksum_errors++;
+
+	uint8_t response_code = 0;
+	if (ft12_get_baos_response_code(bytes, length, frame, &response_code))
+		stats->response_codes[response_code]++;
+	return true;
+}
+
+// Counts an FT 1.2 acknowledgement or fixed length frame,
+// which carries no BAOS telegram.
+// Returns false if it's a variable length frame.
+static bool
+count_link_frame(baos_stats_t *stats, uint8_t type)
+{
+	if (type == FT12_ACK)
+		stats->acks++;
+	else if (type == FT12_FIXED_FRAME)
+		stats->fixed_frames++;
+	else
+		return false;
+	return true;
+}
+
+// Finds the first BAOS frame of a record captured from a serial line,
+// which may start in the middle of a frame, like the "baos_ft12"
+// dissector does. Returns false if the record holds no BAOS frame.
+static bool
+resync_serial_record(baos_stats_t *stats, const uint8_t **payload, size_t *length)
+{
+	if (ft12_find_baos_pattern(*payload, *length) != UINT8_MAX)
+		return true;
+
+	ft12_scanner_t scanner;
+	ft12_scan_result_t frame;
+	const uint8_t *bytes = *payload;
+	size_t remaining = *length;
+
+	ft12_scanner_init(&scanner);
+	ft12_scanner_finish(&scanner);
+	while (ft12_scanner_next(&scanner, &bytes, &remaining, &frame))
+	{
+		if (!ft12_is_baos_pattern_at(frame.bytes, frame.length, 0))
+			continue;
+
+		stats->resyncs++;
+		stats->skipped_bytes += frame.offset;
+		*payload += frame.offset;
+		*length = frame.length;
+		return true;
+	}
+	return false;
+}
+
+// Scans a raw serial byte stream, e.g. the dump of a tapped RS-232 line,
+// for FT 1.2 frames. The stream has no timestamps, so there are no RTTs.
+static void
+analyze_raw_stream(const capture_t *capture, baos_stats_t *stats)
+{
+	ft12_scanner_t scanner;
+	ft12_scan_result_t frame;
+	const uint8_t *bytes = capture->data;
+	size_t length = capture->size;
+
+	// The whole stream is mapped, so it ends with this input
+	ft12_scanner_init(&scanner);
+	ft12_scanner_finish(&scanner);
+	while (ft12_scanner_next(&scanner, &bytes, &length, &frame))
+	{
+		ft12_frame_t baos_frame;
+
+		stats->records++;
+		stats->bytes += frame.length;
+		if (frame.skipped_bytes)
+		{
+			if (stats->resyncs < MAX_REPORTED_RESYNCS)
+				stats->resync_offsets[stats->resyncs] = frame.offset;
+			stats->resyncs++;
+		}
+		if (!count_link_frame(stats, frame.type))
+			count_baos_frame(stats, frame.bytes, frame.length, &baos_frame);
+	}
+	stats->skipped_bytes = scanner.total_skipped_bytes;
+}
+
+// Analyzes the records of a chunk.
+// Returns false if there is no memory left.
+static bool
+analyze_chunk(analyzer_t *analyzer, size_t chunk, baos_stats_t *stats)
+{
+	const capture_t *capture = analyzer->capture;
+	rtt_link_table_t *links = &analyzer->chunk_links[chunk];
+
+	const size_t first_record = chunk * analyzer->chunk_size;
+	const size_t last_record = first_record + analyzer->chunk_size < capture->nr_of_records ?
+									first_record + analyzer->chunk_size : capture->nr_of_records;
+
+	for (size_t i = first_record; i < last_record; i++)
+	{
+		const capture_record_t *record = &capture->records[i];
+		stats->records++;
+		stats->bytes += record->caplen;
+
+		const uint8_t *payload = NULL;
+		size_t length = 0;
+		uint32_t device = 0;
+		ft12_frame_t frame;
+		if (!get_record_payload(capture, record, &payload, &length, &device))
+			continue;
+		if (count_link_frame(stats, ft12_get_short_frame_type(payload, length)))
+			continue;
+		if (record->linktype == LINKTYPE_WIRESHARK_UPPER_PDU && !resync_serial_record(stats, &payload, &length))
+			continue;
+		if (!count_baos_frame(stats, payload, length, &frame))
+			continue;
+
+		// Only requests and their responses take part in RTTs
+		const uint8_t request = frame.subservice & ~BAOS_RESPONSE_FLAG;
+		if (request < GET_SERVER_ITEM_REQ_CODE || request > SET_PARAMETER_BYTE_REQ_CODE)
+			continue;
+
+		rtt_link_t *link = get_rtt_link(links, (uint64_t)device << 8 | request);
+		if (!link)
+			return false;
+
+		if (!(frame.subservice & BAOS_RESPONSE_FLAG))
+		{
+			// A later request replaces an unanswered one
+			link->has_request = true;
+			link->has_pending_request = true;
+			link->pending_request_ts = record->ts;
+		}
+		else if (link->has_pending_request)
+		{
+			add_rtt(&stats->rtt[request], link->pending_request_ts, record->ts);
+			link->has_pending_request = false;
+		}
+		else if (!link->has_request && !link->has_first_response)
+		{
+			// Left for the merge, a chunk before may have sent its request
+			link->has_first_response = true;
+			link->first_response_ts = record->ts;
+		}
+		else
+		{
+			stats->rtt[request].unmatched++;
+		}
+	}
+	return true;
+}
+
+// Analyzes chunks until there are none left. Threads take the next
+// chunk from a shared counter, so threads finishing early keep
+// taking the remaining chunks off the slower ones.
+static void *
+run_worker(void *data)
+{
+	worker_t *worker = data;
+	analyzer_t *analyzer = worker->analyzer;
+
+	for (;;)
+	{
+		const size_t chunk = atomic_fetch_add_explicit(&analyzer->next_chunk, 1, memory_order_relaxed);
+		if (chunk >= analyzer->nr_of_chunks)
+			break;
+
+		if (!analyze_chunk(analyzer, chunk, &worker->stats))
+			return worker;
+	}
+	return NULL;
+}
+
+static void
+merge_stats(baos_stats_t *total, const baos_stats_t *stats)
+{
+	total->records += stats->records;
+	total->bytes += stats->bytes;
+	total->ft12_frames += stats->ft12_frames;
+	total->checksum_errors += stats->checksum_errors;
+	total->incomplete_frames += stats->incomplete_frames;
+	total->acks += stats->acks;
+	total->fixed_frames += stats->fixed_frames;
+	total->resyncs += stats->resyncs;
+	total->skipped_bytes += stats->skipped_bytes;
+
+	for (size_t i = 0; i < 256; i++)
+	{
+		total->subservices[i] += stats->subservices[i];
+		total->response_codes[i] += stats->response_codes[i];
+	}
+
+	for (size_t i = 0; i < NR_OF_REQUESTS; i++)
+	{
+		rtt_stats_t *total_rtt = &total->rtt[i];
+		const rtt_stats_t *rtt = &stats->rtt[i];
+
+		if (rtt->count)
+		{
+			total_rtt->min = total_rtt->count ? (rtt->min < total_rtt->min ? rtt->min : total_rtt->min) : rtt->min;
+			total_rtt->max = rtt->max > total_rtt->max ? rtt->max : total_rtt->max;
+		}
+		total_rtt->count += rtt->count;
+		total_rtt->sum += rtt->sum;
+		total_rtt->unmatched += rtt->unmatched;
+		for (size_t j = 0; j < RTT_BUCKETS; j++)
+			total_rtt->buckets[j] += rtt->buckets[j];
+	}
+}
+
+// Matches the first responses of the chunks with the requests
+// left pending by the chunks before, in capture order.
+// Returns false if there is no memory left.
+static bool
+merge_chunk_links(analyzer_t *analyzer, baos_stats_t *total)
+{
+	rtt_link_table_t pending = { 0 };
+	bool is_ok = true;
+
+	for (size_t chunk = 0; chunk < analyzer->nr_of_chunks && is_ok; chunk++)
+	{
+		const rtt_link_table_t *links = &analyzer->chunk_links[chunk];
+
+		for (size_t i = 0; i < links->capacity; i++)
+		{
+			const rtt_link_t *link = &links->links[i];
+			if (!link->is_used)
+				continue;
+
+			rtt_link_t *pending_link = get_rtt_link(&pending, link->key);
+			if (!pending_link)
+			{
+				is_ok = false;
+				break;
+			}
+
+			rtt_stats_t *rtt = &total->rtt[link->key & 0xFF];
+			if (link->has_first_response)
+			{
+				if (pending_link->has_pending_request)
+					add_rtt(rtt, pending_link->pending_request_ts, link->first_response_ts);
+				else
+					rtt->unmatched++;
+			}
+
+			// Every request or response of the chunk replaces what was pending before
+			pending_link->has_pending_request = link->has_pending_request;
+			pending_link->pending_request_ts = link->pending_request_ts;
+		}
+	}
+
+	free(pending.links);
+	return is_ok;
+}
+
+// Finds the round trip time below which the given share of all RTTs is
+// Returns the start of the bucket holding the percentile.
+static uint64_t
+get_rtt_percentile(const rtt_stats_t *stats, double share)
+{
+	const uint64_t rank = (uint64_t)(share * (double)stats->count);
+	uint64_t count = 0;
+
+	for (size_t i = 0; i < RTT_BUCKETS; i++)
+	{
+		count += stats->buckets[i];
+		if (count > rank)
+		{
+			const uint64_t rtt = get_rtt_bucket_start(i);
+			return rtt < stats->min ? stats->min : rtt;
+		}
+	}
+	return stats->max;
+}
+
+static double
+get_percentage(uint64_t part, uint64_t whole)
+{
+	return whole ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+static void
+print_report(const char *path, const capture_t *capture, const baos_stats_t *total,
+				unsigned nr_of_threads, const analyzer_t *analyzer, double index_seconds, double analyze_seconds)
+{
+	const double seconds = index_seconds + analyze_seconds;
+
+	printf("File:             %s (%s, %zu bytes)\n", path, capture->format, capture->size);
+	if (capture->is_raw)
+	{
+		printf("Frames:           %" PRIu64 " (%" PRIu64 " bytes)\n", total->records, total->bytes);
+		printf("Threads:          1, raw streams are scanned from start to end\n");
+	}
+	else
+	{
+		printf("Records:          %" PRIu64 " (%" PRIu64 " bytes captured)\n", total->records, total->bytes);
+		if (capture->skipped_blocks)
+			printf("Skipped blocks:   %" PRIu64 "\n", capture->skipped_blocks);
+		printf("Threads:          %u, %zu chunks of %zu records\n", nr_of_threads, analyzer->nr_of_chunks, analyzer->chunk_size);
+	}
+	printf("Time:             %.3f s (index %.3f s, analysis %.3f s), %.1f MB/s\n",
+			seconds, index_seconds, analyze_seconds,
+			seconds > 0 ? (double)capture->size / seconds / 1e6 : 0.0);
+
+	printf("\nFT 1.2 frames:    %" PRIu64 "\n", total->ft12_frames);
+	printf("Checksum errors:  %" PRIu64 " (%.2f %%)\n",
+			total->checksum_errors, get_percentage(total->checksum_errors, total->ft12_frames));
+	printf("Incomplete:       %" PRIu64 " (%.2f %%)\n",
+			total->incomplete_frames, get_percentage(total->incomplete_frames, total->ft12_frames));
+	printf("Acknowledgements: %" PRIu64 "\n", total->acks);
+	printf("Fixed frames:     %" PRIu64 "\n", total->fixed_frames);
+	printf("Resyncs:          %" PRIu64 " (%" PRIu64 " bytes skipped)\n", total->resyncs, total->skipped_bytes);
+	for (uint64_t i = 0; capture->is_raw && i < total->resyncs && i < MAX_REPORTED_RESYNCS; i++)
+		printf("  at offset %" PRIu64 "\n", total->resync_offsets[i]);
+
+	printf("\nSubservices\n");
+	for (size_t i = 0; i < 256; i++)
+	{
+		if (total->subservices[i])
+			printf("  %-30s 0x%02zX %12" PRIu64 " (%6.2f %%)\n", get_name(subservice_names, (uint8_t)i), i,
+					total->subservices[i], get_percentage(total->subservices[i], total->ft12_frames));
+	}
+
+	uint64_t nr_of_responses = 0;
+	for (size_t i = 0; i < 256; i++)
+		nr_of_responses += total->response_codes[i];
+
+	printf("\nObject server responses\n");
+	for (size_t i = 0; i < 256; i++)
+	{
+		if (total->response_codes[i])
+			printf("  %-30s 0x%02zX %12" PRIu64 " (%6.2f %%)\n", get_name(response_code_names, (uint8_t)i), i,
+					total->response_codes[i], get_percentage(total->response_codes[i], nr_of_responses));
+	}
+
+	printf("\nRound trip times in ms\n");
+	printf("  %-30s %10s %10s %9s %9s %9s %9s %9s\n", "Request", "Count", "Unmatched", "Min", "Avg", "p50", "p99", "Max");
+	for (size_t i = 0; i < NR_OF_REQUESTS; i++)
+	{
+		const rtt_stats_t *rtt = &total->rtt[i];
+		if (!rtt->count && !rtt->unmatched)
+			continue;
+
+		printf("  %-30s %10" PRIu64 " %10" PRIu64 " %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+				get_name(subservice_names, (uint8_t)i), rtt->count, rtt->unmatched,
+				(double)rtt->min / 1e6,
+				rtt->count ? (double)rtt->sum / (double)rtt->count / 1e6 : 0.0,
+				(double)get_rtt_percentile(rtt, 0.5) / 1e6,
+				(double)get_rtt_percentile(rtt, 0.99) / 1e6,
+				(double)rtt->max / 1e6);
+	}
+}
+
+static void
+print_usage(FILE *stream)
+{
+	fprintf(stream,
+			"Usage: baos-analyzer [-j threads] [-c records] [-r] capture\n"
+			"\n"
+			"Analyzes the serial BAOS traffic of a pcap or pcapng capture.\n"
+			"\n"
+			"  -j threads  number of threads (default: number of CPUs)\n"
+			"  -c records  records per chunk handed to a thread (default: %d)\n"
+			"  -r          the capture is a raw dump of a serial line\n"
+			"  -h          show this help\n",
+			DEFAULT_CHUNK_SIZE);
+}
+
+int
+main(int argc, char *argv[])
+{
+	long nr_of_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	long chunk_size = DEFAULT_CHUNK_SIZE;
+	bool is_raw = false;
+	int option;
+
+	while ((option = getopt(argc, argv, "j:c:rh")) != -1)
+	{
+		switch (option)
+		{
+			case 'j':
+				nr_of_threads = strtol(optarg, NULL, 10);
+				break;
+			case 'c':
+				chunk_size = strtol(optarg, NULL, 10);
+				break;
+			case 'r':
+				is_raw = true;
+				break;
+			case 'h':
+				print_usage(stdout);
+				return 0;
+			default:
+				print_usage(stderr);
+				return 1;
+		}
+	}
+	if (optind != argc - 1 || nr_of_threads < 1 || chunk_size < 1)
+	{
+		print_usage(stderr);
+		return 1;
+	}
+	if (nr_of_threads > MAX_THREADS)
+		nr_of_threads = MAX_THREADS;
+
+	const char *path = argv[optind];
+	const double started = get_seconds();
+
+	// Map the whole file, records are read in place
+	const int fd = open(path, O_RDONLY);
+	struct stat file_stat;
+	if (fd < 0 || fstat(fd, &file_stat) < 0)
+	{
+		fprintf(stderr, "baos-analyzer: %s: %s\n", path, strerror(errno));
+		return 1;
+	}
+	if (!file_stat.st_size)
+	{
+		fprintf(stderr, "baos-analyzer: %s: file is empty\n", path);
+		return 1;
+	}
+	if (file_stat.st_size < 4 && !is_raw)
+	{
+		fprintf(stderr, "baos-analyzer: %s: not a pcap or pcapng file\n", path);
+		return 1;
+	}
+
+	capture_t capture = { 0 };
+	capture.size = (size_t)file_stat.st_size;
+	void *mapping = mmap(NULL, capture.size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		fprintf(stderr, "baos-analyzer: %s: %s\n", path, strerror(errno));
+		return 1;
+	}
+	capture.data = mapping;
+	madvise(mapping, capture.size, MADV_SEQUENTIAL);
+
+	if (is_raw)
+	{
+		baos_stats_t *raw_total = calloc(1, sizeof(baos_stats_t));
+		if (!raw_total)
+		{
+			fprintf(stderr, "baos-analyzer: out of memory\n");
+			return 1;
+		}
+
+		const analyzer_t raw_analyzer = { 0 };
+		capture.format = "raw serial stream";
+		capture.is_raw = true;
+		analyze_raw_stream(&capture, raw_total);
+		print_report(path, &capture, raw_total, 1, &raw_analyzer, 0, get_seconds() - started);
+
+		free(raw_total);
+		munmap(mapping, capture.size);
+		return 0;
+	}
+
+	// Index the records, which can only be found one after another
+	const uint32_t magic = read_u32(capture.data, false);
+	bool is_ok = false;
+	if (magic == PCAP_MAGIC_USEC || magic == PCAP_MAGIC_USEC_SWAPPED ||
+		magic == PCAP_MAGIC_NSEC || magic == PCAP_MAGIC_NSEC_SWAPPED)
+		is_ok = index_pcap(&capture, magic);
+	else if (magic == PCAPNG_SHB)
+		is_ok = index_pcapng(&capture);
+	else
+		fprintf(stderr, "baos-analyzer: %s: not a pcap or pcapng file\n", path);
+
+	if (!is_ok)
+		return 1;
+
+	const double indexed = get_seconds();
+
+	// Analyze the chunks on the pool of threads
+	analyzer_t analyzer = { 0 };
+	analyzer.capture = &capture;
+	analyzer.chunk_size = (size_t)chunk_size;
+	analyzer.nr_of_chunks = (capture.nr_of_records + analyzer.chunk_size - 1) / analyzer.chunk_size;
+	analyzer.chunk_links = calloc(analyzer.nr_of_chunks ? analyzer.nr_of_chunks : 1, sizeof(rtt_link_table_t));
+	atomic_init(&analyzer.next_chunk, 0);
+
+	worker_t *workers = calloc((size_t)nr_of_threads, sizeof(worker_t));
+	if (!analyzer.chunk_links || !workers)
+	{
+		fprintf(stderr, "baos-analyzer: out of memory\n");
+		return 1;
+	}
+
+	long nr_of_started = 0;
+	for (; nr_of_started < nr_of_threads; nr_of_started++)
+	{
+		workers[nr_of_started].analyzer = &analyzer;
+		if (pthread_create(&workers[nr_of_started].thread, NULL, run_worker, &workers[nr_of_started]))
+			break;
+	}
+	if (!nr_of_started)
+	{
+		fprintf(stderr, "baos-analyzer: can't start any thread\n");
+		return 1;
+	}
+
+	baos_stats_t *total = calloc(1, sizeof(baos_stats_t));
+	for (long i = 0; i < nr_of_started; i++)
+	{
+		void *failed = NULL;
+		pthread_join(workers[i].thread, &failed);
+		if (failed)
+			is_ok = false;
+	}
+	if (!total || !is_ok)
+	{
+		fprintf(stderr, "baos-analyzer: out of memory\n");
+		return 1;
+	}
+
+	for (long i = 0; i < nr_of_started; i++)
+		merge_stats(total, &workers[i].stats);
+	if (!merge_chunk_links(&analyzer, total))
+	{
+		fprintf(stderr, "baos-analyzer: out of memory\n");
+		return 1;
+	}
+
+	const double finished = get_seconds();
+	print_report(path, &capture, total, (unsigned)nr_of_started, &analyzer, indexed - started, finished - indexed);
+
+	for (size_t i = 0; i < analyzer.nr_of_chunks; i++)
+		free(analyzer.chunk_links[i].links);
+	free(analyzer.chunk_links);
+	free(workers);
+	free(total);
+	free(capture.records);
+	munmap(mapping, capture.size);
+	return 0;
+}
@@ -0,0 +1,627 @@
+#!/usr/bin/env python3
+#
+# baos-capture-gen.py
+#
+# Generates synthetic captures of serial BAOS traffic
+# By Adam Rigely <adamrigely@pm.me>
+#
+# The telegrams are built from the subservice codes, control bytes,
+# response codes and datapoint types defined in packet-baos.h and ft12.h,
+# wrapped into FT 1.2 frames and written as USB bulk transfers (Linux
+# usbmon, memory-mapped header) into a pcapng file, which can be
+# dissected by the BAOS plugin like a real capture.
+#
+# The default traffic covers every subservice but SetServerItem, which is
+# only written by the write-server-items scenario (--scenario), added after
+# the first version of the generator, so that the default captures and the
+# golden output of the regression tests stayed the same.
+#
+# Wireshark - Network traffic analyzer
+# By Gerald Combs <gerald@wireshark.org>
+# Copyright 1998 Gerald Combs
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+
+import argparse
+import os
+import random
+import re
+import struct
+import sys
+import time
+
+BAOS_PLUGIN_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               '..', 'plugins', 'epan', 'baos')
+DEFAULT_HEADERS = [os.path.join(BAOS_PLUGIN_DIR, 'packet-baos.h'),
+                   os.path.join(BAOS_PLUGIN_DIR, 'ft12.h')]
+
+# LINKTYPE_USB_LINUX_MMAPPED
+LINKTYPE_USB_LINUX_MMAPPED = 220
+
+# Largest BAOS payload fitting into the length byte of an FT 1.2 frame
+# (the length also covers the control byte)
+MAX_BAOS_PAYLOAD = 254
+
+# Value types which can be selected on the command line.
+# Each maps to the value type and datapoint type used
+# in the datapoint descriptions, and to the value length.
+VALUE_TYPES = {
+    '1bit':   ('DP_VT_1BIT',   'DPT1',  1),
+    '2bit':   ('DP_VT_2BIT',   'DPT2',  1),
+    '4bit':   ('DP_VT_4BIT',   'DPT3',  1),
+    '1byte':  ('DP_VT_1BYTE',  'DPT5',  1),
+    '2byte':  ('DP_VT_2BYTE',  'DPT9',  2),
+    '3byte':  ('DP_VT_3BYTE',  'DPT10', 3),
+    '4byte':  ('DP_VT_4BYTE',  'DPT14', 4),
+    '8byte':  ('DP_VT_8BYTE',  'DPT19', 8),
+    '14byte': ('DP_VT_14BYTE', 'DPT16', 14),
+}
+
+# Server items answered by the generated devices
+SERVER_ITEMS = {
+    'HARDWARE_TYPE':            bytes.fromhex('000000000700'),
+    'HARDWARE_VERSION':         b'\x10',
+    'FIRMWARE_VERSION':         b'\x21',
+    'KNX_MANUFACTURER_CODE_DEV': b'\x00\xc5',
+    'KNX_MANUFACTURER_CODE_APP': b'\x00\xc5',
+    'APPLICATION_ID_ETS':       b'\x07\x01',
+    'APPLICATION_VERSION_ETS':  b'\x20',
+    'SERIAL_NUMBER':            bytes.fromhex('00c5010203'),
+    'TIME_SINCE_RESET':         b'\x00\x00\x00\x00',
+    'BUS_CONNECTION_STATE':     b'\x01',
+    'MAX_BUFFER_SIZE':          b'\x00\xfa',
+    'LENGTH_OF_DESC_STRING':    b'\x00\x1e',
+    'BAUDRATE':                 b'\x02',
+    'CURRENT_BUFF_SIZE':        b'\x00\xfa',
+    'PROGRAMMING_MODE':         b'\x00',
+    'PROTO_VERSION_BIN':        b'\x20',
+    'INDICATION_SENDING':       b'\x01',
+}
+
+SIZE_SUFFIXES = {'': 1, 'K': 1 << 10, 'M': 1 << 20, 'G': 1 << 30}
+
+
+class BaosDefinitions:
+    '''Enums and defines parsed from packet-baos.h'''
+
+    ENUM_RE = re.compile(r'enum\s+(\w+)\s*\{([^}]*)\}', re.S)
+    ENTRY_RE = re.compile(r'(\w+)\s*=\s*(0x[0-9A-Fa-f\']+|0b[01\']+|\d+)')
+    DEFINE_RE = re.compile(r'#define\s+(\w+)\s+(0x[0-9A-Fa-f]+|\d+)\s*$', re.M)
+
+    def __init__(self, header_paths):
+        source = ''
+        for header_path in header_paths:
+            with open(header_path, encoding='utf-8') as header:
+                source += header.read() + '\n'
+        header_path = ', '.join(header_paths)
+        # Drop comments, so that commented out entries are not picked up
+        source = re.sub(r'//[^\n]*', '', source)
+        source = re.sub(r'/\*.*?\*/', '', source, flags=re.S)
+
+        self.enums = {}
+        for enum_name, body in self.ENUM_RE.findall(source):
+            self.enums[enum_name] = {
+                name: int(value.replace("'", ''), 0)
+                for name, value in self.ENTRY_RE.findall(body)
+            }
+        self.defines = {name: int(value, 0) for name, value in self.DEFINE_RE.findall(source)}
+
+        for enum_name in ('SUBSERVICE_CODES', 'OBJECT_SERVER_RESPONSE_CODES', 'CONTROL_BYTES',
+                          'SERVER_ITEMS', 'BAOS_DPTS', 'BAOS_DP_VALUE_TYPES', 'DP_COMMANDS',
+                          'DP_FILTERS', 'DP_STATE_TRANSMISSION_STATES'):
+            if enum_name not in self.enums:
+                raise ValueError(f'enum {enum_name} not found in {header_path}')
+        for define_name in ('FT12_START_BYTE', 'FT12_END_BYTE', 'BAOS_MAINSERVICE_CODE'):
+            if define_name not in self.defines:
+                raise ValueError(f'define {define_name} not found in {header_path}')
+
+    def subservice(self, name):
+        return self.enums['SUBSERVICE_CODES'][name + '_CODE']
+
+    def __getitem__(self, name):
+        for entries in self.enums.values():
+            if name in entries:
+                return entries[name]
+        return self.defines[name]
+
+
+class PcapngWriter:
+    '''Writes a single USB interface into a pcapng file, buffering the blocks'''
+
+    FLUSH_SIZE = 4 << 20
+
+    def __init__(self, file):
+        self.file = file
+        self.chunks = []
+        self.buffered = 0
+        self.written = 0
+
+        # Section header block, section length unknown
+        shb_body = struct.pack('<IHHq', 0x1A2B3C4D, 1, 0, -1)
+        self._write_block(0x0A0D0D0A, shb_body)
+        # Interface description block with microsecond timestamps
+        idb_body = struct.pack('<HHI', LINKTYPE_USB_LINUX_MMAPPED, 0, 0)
+        self._write_block(0x00000001, idb_body)
+
+    def _write_block(self, block_type, body):
+        total_length = 12 + len(body)
+        block = struct.pack('<II', block_type, total_length) + body + struct.pack('<I', total_length)
+        self.chunks.append(block)
+        self.buffered += len(block)
+        if self.buffered >= self.FLUSH_SIZE:
+            self.flush()
+
+    def write_packet(self, ts_usec, data):
+        padding = b'\0' * (-len(data) % 4)
+        body = struct.pack('<IIIII', 0, ts_usec >> 32, ts_usec & 0xFFFFFFFF, len(data), len(data))
+        self._write_block(0x00000006, body + data + padding)
+
+    def flush(self):
+        self.file.write(b''.join(self.chunks))
+        self.written += self.buffered
+        self.chunks = []
+        self.buffered = 0
+
+    def size(self):
+        return self.written + self.buffered
+
+
+def encode_dpt9(value):
+    '''Encodes a value as a KNX 2-byte float'''
+    mantissa = round(value * 100)
+    exponent = 0
+    while not -2048 <= mantissa <= 2047:
+        mantissa >>= 1
+        exponent += 1
+    sign = 0x8000 if mantissa < 0 else 0
+    return struct.pack('>H', sign | (exponent << 11) | (mantissa & 0x7FF))
+
+
+class Datapoint:
+    def __init__(self, dp_id, value_type, defs, rng):
+        vt_name, dpt_name, length = VALUE_TYPES[value_type]
+        self.dp_id = dp_id
+        self.kind = value_type
+        self.value_type = defs[vt_name]
+        self.dpt = defs[dpt_name]
+        self.length = length
+        self.name = f'{value_type.upper()} datapoint {dp_id}'.encode('ascii')
+        self.value = self.random_value(rng)
+
+    def random_value(self, rng):
+        kind = self.kind
+        if kind == '1bit':
+            return bytes((rng.getrandbits(1),))
+        if kind == '2bit':
+            return bytes((rng.getrandbits(2),))
+        if kind == '4bit':
+            return bytes((rng.getrandbits(4),))
+        if kind == '2byte':
+            return encode_dpt9(rng.uniform(-20.0, 40.0))
+        if kind == '3byte':
+            return bytes((rng.randrange(1, 8) << 5 | rng.randrange(24), rng.randrange(60), rng.randrange(60)))
+        if kind == '4byte':
+            return struct.pack('>f', rng.uniform(0.0, 10000.0))
+        if kind == '8byte':
+            return bytes((rng.randrange(90, 130), rng.randrange(1, 13), rng.randrange(1, 29),
+                          rng.randrange(24), rng.randrange(60), rng.randrange(60), 0, 0))
+        if kind == '14byte':
+            text = f'Value {rng.randrange(100000)}'.encode('ascii')
+            return text[:14].ljust(14, b'\0')
+        return rng.randbytes(self.length)
+
+
+class Device:
+    '''A BAOS device on its own USB address with its datapoints and parameter bytes'''
+
+    def __init__(self, index, args, defs, rng):
+        self.defs = defs
+        self.rng = rng
+        self.bus_id = 1
+        self.address = index + 2
+        self.urb_id = 0xFFFF880000000000 | (index << 32)
+        self.tx_odd = True
+        self.rx_odd = True
+        value_types = args.value_types
+        self.dps = [Datapoint(dp_id, value_types[(dp_id - 1) % len(value_types)], defs, rng)
+                    for dp_id in range(1, args.datapoints + 1)]
+        self.param_bytes = bytearray(rng.randbytes(args.param_bytes))
+
+    def next_control_byte(self, to_device):
+        defs = self.defs
+        if to_device:
+            control_byte = defs['CR_TX_ODD'] if self.tx_odd else defs['CR_TX_EVEN']
+            self.tx_odd = not self.tx_odd
+        else:
+            control_byte = defs['CR_RX_ODD'] if self.rx_odd else defs['CR_RX_EVEN']
+            self.rx_odd = not self.rx_odd
+        return control_byte
+
+
+class Generator:
+    def __init__(self, args, defs, writer):
+        self.args = args
+        self.defs = defs
+        self.writer = writer
+        self.rng = random.Random(args.seed)
+        self.devices = [Device(i, args, defs, self.rng) for i in range(args.devices)]
+        self.ts_usec = int(args.start_time * 1_000_000)
+        self.telegrams = 0
+
+        self.error_codes = [code for name, code in defs.enums['OBJECT_SERVER_RESPONSE_CODES'].items()
+                            if name != 'SUCCESS']
+        self.server_items = [(defs[name], data) for name, data in SERVER_ITEMS.items()
+                             if name in defs.enums['SERVER_ITEMS']]
+
+        # Weighted steady state traffic. Writing server items is only
+        # generated on request, so that the default traffic stays the same.
+        self.scenarios = [
+            (self.poll_datapoints, 40),
+            (self.write_datapoints, 15),
+            (self.indicate_datapoints, 30),
+            (self.read_parameter_bytes, 5),
+            (self.write_parameter_bytes, 2),
+            (self.read_server_items, 5),
+            (self.indicate_server_items, 3),
+            (self.write_server_items, 0),
+        ]
+        if args.scenarios:
+            self.scenarios = [(func, weight or 1) for func, weight in self.scenarios
+                              if scenario_name(func) in args.scenarios]
+        self.scenario_funcs = [func for func, _ in self.scenarios]
+        self.scenario_weights = [weight for _, weight in self.scenarios]
+
+    #
+    # Framing
+    #
+
+    def ft12_frame(self, control_byte, baos_payload):
+        length = len(baos_payload) + 1
+        checksum = (control_byte + sum(baos_payload)) & 0xFF
+        start_byte = self.defs['FT12_START_BYTE']
+        frame = bytearray((start_byte, length, length, start_byte, control_byte))
+        frame += baos_payload
+        frame += bytes((checksum, self.defs['FT12_END_BYTE']))
+
+        # Corrupt some frames to exercise the error paths of the dissector
+        if self.args.corrupt_rate and self.rng.random() < self.args.corrupt_rate:
+            corruption = self.rng.randrange(3)
+            if corruption == 0:
+                frame[-2] ^= 0xFF
+            elif corruption == 1:
+                frame[-1] = 0x00
+            else:
+                del frame[self.rng.randrange(7, len(frame)):]
+        return bytes(frame)
+
+    def usb_record(self, device, to_device, data):
+        # Host to device data is captured on URB submission,
+        # device to host data on URB completion
+        device.urb_id += 1
+        event_type = b'S' if to_device else b'C'
+        endpoint = 0x02 if to_device else 0x81
+        ts_sec, ts_usec = divmod(self.ts_usec, 1_000_000)
+        header = struct.pack(
+            '<Q1sBBBHbbqiiII8siiII',
+            device.urb_id,
+            event_type,
+            3,                          # URB_BULK
+            endpoint,
+            device.address,
+            device.bus_id,
+            ord('-'),                   # No setup packet
+            0,                          # Data present
+            ts_sec,
+            ts_usec,
+            -115 if to_device else 0,   # -EINPROGRESS on submission
+            len(data),
+            len(data),
+            b'\0' * 8,
+            0, 0, 0, 0)
+        return header + data
+
+    def emit(self, device, to_device, subservice, body, delay_usec):
+        self.ts_usec += delay_usec
+        baos_payload = bytes((self.defs['BAOS_MAINSERVICE_CODE'], self.defs.subservice(subservice))) + body
+        frame = self.ft12_frame(device.next_control_byte(to_device), baos_payload)
+        self.writer.write_packet(self.ts_usec, self.usb_record(device, to_device, frame))
+        self.telegrams += 1
+
+    def request(self, device, subservice, body):
+        self.emit(device, True, subservice, body, self.gap())
+
+    def response(self, device, subservice, body):
+        self.emit(device, False, subservice, body, self.latency())
+
+    def error_response(self, device, subservice, start):
+        code = self.rng.choice(self.error_codes)
+        self.response(device, subservice, struct.pack('>HHB', start, 0, code))
+
+    def is_error(self):
+        return self.args.error_rate and self.rng.random() < self.args.error_rate
+
+    def gap(self):
+        return max(1, int(self.rng.expovariate(1.0 / self.args.interval)))
+
+    def latency(self):
+        return self.rng.randrange(2000, 15000)
+
+    #
+    # Helpers for ranges of datapoints
+    #
+
+    def dp_range(self, device, entry_size):
+        '''Picks a range of datapoints fitting into a single telegram'''
+        max_dps = max(1, (MAX_BAOS_PAYLOAD - 6) // entry_size)
+        first = self.rng.randrange(len(device.dps))
+        count = self.rng.randint(1, min(max_dps, len(device.dps) - first))
+        return device.dps[first:first + count]
+
+    def dp_values(self, device, dps, state):
+        entries = []
+        size = 6
+        for dp in dps:
+            entry = struct.pack('>HBB', dp.dp_id, state, dp.length) + dp.value
+            if size + len(entry) > MAX_BAOS_PAYLOAD:
+                break
+            entries.append(entry)
+            size += len(entry)
+        return entries
+
+    #
+    # Scenarios
+    #
+
+    def startup(self, device):
+        '''Reads the server items, datapoint descriptions and names like a host application would'''
+        self.read_server_items(device, everything=True)
+
+        for first in range(0, len(device.dps), 40):
+            dps = device.dps[first:first + 40]
+            start = dps[0].dp_id
+            self.request(device, 'GET_DATAPOINT_DESC_REQ', struct.pack('>HH', start, len(dps)))
+            body = struct.pack('>HH', start, len(dps)) + b''.join(
+                struct.pack('>HBBB', dp.dp_id, dp.value_type, 0b0101_0111, dp.dpt) for dp in dps)
+            self.response(device, 'GET_DATAPOINT_DESC_RES', body)
+
+        first = 0
+        while first < len(device.dps):
+            dps = []
+            size = 6
+            for dp in device.dps[first:]:
+                if size + len(dp.name) + 2 > MAX_BAOS_PAYLOAD:
+                    break
+                dps.append(dp)
+                size += len(dp.name) + 2
+            start = dps[0].dp_id
+            self.request(device, 'GET_DESC_STRING_REQ', struct.pack('>HH', start, len(dps)))
+            body = struct.pack('>HH', start, len(dps)) + b''.join(
+                struct.pack('>H', len(dp.name)) + dp.name for dp in dps)
+            self.response(device, 'GET_DESC_STRING_RES', body)
+            first += len(dps)
+
+    def poll_datapoints(self, device):
+        dps = self.dp_range(device, 4 + 14)
+        start = dps[0].dp_id
+        dp_filter = self.rng.choice(list(self.defs.enums['DP_FILTERS'].values()))
+        self.request(device, 'GET_DATAPOINT_VALUE_REQ', struct.pack('>HHB', start, len(dps), dp_filter))
+        if self.is_error():
+            self.error_response(device, 'GET_DATAPOINT_VALUE_RES', start)
+            return
+        entries = self.dp_values(device, dps, 0b0001_0000 | self.defs['IDLE_OK'])
+        body = struct.pack('>HH', start, len(entries)) + b''.join(entries)
+        self.response(device, 'GET_DATAPOINT_VALUE_RES', body)
+
+    def write_datapoints(self, device):
+        dps = self.dp_range(device, 4 + 14)[:self.rng.randint(1, 4)]
+        command = self.defs['SET_NEW_VALUE_SEND_ON_BUS']
+        for dp in dps:
+            dp.value = dp.random_value(self.rng)
+        body = struct.pack('>HH', dps[0].dp_id, len(dps)) + b''.join(
+            struct.pack('>HBB', dp.dp_id, command, dp.length) + dp.value for dp in dps)
+        self.request(device, 'SET_DATAPOINT_VALUE_REQ', body)
+        if self.is_error():
+            self.error_response(device, 'SET_DATAPOINT_VALUE_RES', dps[0].dp_id)
+            return
+        self.response(device, 'SET_DATAPOINT_VALUE_RES', struct.pack('>HHB', dps[0].dp_id, 0, self.defs['SUCCESS']))
+
+        # The device confirms the transmission on the bus
+        trans_state = self.defs['IDLE_ERROR'] if self.is_error() else self.defs['IDLE_OK']
+        entries = self.dp_values(device, dps, 0b0001_0000 | trans_state)
+        body = struct.pack('>HH', dps[0].dp_id, len(entries)) + b''.join(entries)
+        self.emit(device, False, 'DATAPOINT_VALUE_IND', body, self.rng.randrange(20000, 80000))
+
+    def indicate_datapoints(self, device, burst=False):
+        dps = self.dp_range(device, 4 + 14)[:self.rng.randint(1, 8)]
+        for dp in dps:
+            dp.value = dp.random_value(self.rng)
+        entries = self.dp_values(device, dps, 0b0001_1000 | self.defs['IDLE_OK'])
+        body = struct.pack('>HH', dps[0].dp_id, len(entries)) + b''.join(entries)
+        delay = self.rng.randrange(500, 3000) if burst else self.gap()
+        self.emit(device, False, 'DATAPOINT_VALUE_IND', body, delay)
+
+    def read_parameter_bytes(self, device):
+        if not device.param_bytes:
+            return
+        first = self.rng.randrange(len(device.param_bytes))
+        count = self.rng.randint(1, min(64, len(device.param_bytes) - first))
+        self.request(device, 'GET_PARAMETER_BYTE_REQ', struct.pack('>HH', first + 1, count))
+        if self.is_error():
+            self.error_response(device, 'GET_PARAMETER_BYTE_RES', first + 1)
+            return
+        body = struct.pack('>HH', first + 1, count) + bytes(device.param_bytes[first:first + count])
+        self.response(device, 'GET_PARAMETER_BYTE_RES', body)
+
+    def write_parameter_bytes(self, device):
+        if not device.param_bytes:
+            return
+        first = self.rng.randrange(len(device.param_bytes))
+        count = self.rng.randint(1, min(16, len(device.param_bytes) - first))
+        values = self.rng.randbytes(count)
+        self.request(device, 'SET_PARAMETER_BYTE_REQ', struct.pack('>HH', first + 1, count) + values)
+        if self.is_error():
+            self.error_response(device, 'SET_PARAMETER_BYTE_RES', first + 1)
+            return
+        device.param_bytes[first:first + count] = values
+        self.response(device, 'SET_PARAMETER_BYTE_RES', struct.pack('>HHB', first + 1, 0, self.defs['SUCCESS']))
+
+    def server_item_entries(self, items):
+        return b''.join(struct.pack('>HB', item_id, len(data)) + data for item_id, data in items)
+
+    def read_server_items(self, device, everything=False):
+        items = self.server_items
+        if not everything:
+            first = self.rng.randrange(len(items))
+            items = items[first:first + self.rng.randint(1, 4)]
+        start = items[0][0]
+        count = items[-1][0] - start + 1
+        self.request(device, 'GET_SERVER_ITEM_REQ', struct.pack('>HH', start, count))
+        if self.is_error():
+            self.error_response(device, 'GET_SERVER_ITEM_RES', start)
+            return
+        body = struct.pack('>HH', start, len(items)) + self.server_item_entries(items)
+        self.response(device, 'GET_SERVER_ITEM_RES', body)
+
+    def indicate_server_items(self, device):
+        # Bus connection state and programming mode toggling
+        items = [(self.defs['BUS_CONNECTION_STATE'], bytes((self.rng.getrandbits(1),))),
+                 (self.defs['PROGRAMMING_MODE'], bytes((self.rng.getrandbits(1),)))]
+        item = self.rng.choice(items)
+        body = struct.pack('>HH', item[0], 1) + self.server_item_entries([item])
+        self.emit(device, False, 'SERVER_ITEM_IND', body, self.gap())
+
+    def write_server_items(self, device):
+        # Programming mode and indication sending, as switched by a host application
+        items = [(self.defs['PROGRAMMING_MODE'], bytes((self.rng.getrandbits(1),))),
+                 (self.defs['INDICATION_SENDING'], bytes((self.rng.getrandbits(1),)))]
+        items = self.rng.choice((items[:1], items[1:], items))
+        start = items[0][0]
+        body = struct.pack('>HH', start, len(items)) + self.server_item_entries(items)
+        self.request(device, 'SET_SERVER_ITEM_REQ', body)
+        if self.is_error():
+            self.error_response(device, 'SET_SERVER_ITEM_RES', start)
+            return
+        self.response(device, 'SET_SERVER_ITEM_RES', struct.pack('>HHB', start, 0, self.defs['SUCCESS']))
+
+    #
+    # Main loop
+    #
+
+    def is_done(self):
+        if self.args.telegrams and self.telegrams >= self.args.telegrams:
+            return True
+        return self.args.size and self.writer.size() >= self.args.size
+
+    def run(self):
+        for device in self.devices:
+            self.startup(device)
+
+        rng = self.rng
+        while not self.is_done():
+            device = rng.choice(self.devices)
+            if self.args.burst_rate and rng.random() < self.args.burst_rate:
+                for _ in range(rng.randint(self.args.burst_length // 2 or 1, self.args.burst_length)):
+                    self.indicate_datapoints(device, burst=True)
+                continue
+            rng.choices(self.scenario_funcs, self.scenario_weights)[0](device)
+        self.writer.flush()
+
+
+def scenario_name(func):
+    return func.__name__.replace('_', '-')
+
+
+SCENARIOS = [scenario_name(func) for func in (
+    Generator.poll_datapoints, Generator.write_datapoints, Generator.indicate_datapoints,
+    Generator.read_parameter_bytes, Generator.write_parameter_bytes, Generator.read_server_items,
+    Generator.indicate_server_items, Generator.write_server_items)]
+
+
+def parse_size(text):
+    match = re.fullmatch(r'(\d+)\s*([KMG]?)B?', text.strip().upper())
+    if not match:
+        raise argparse.ArgumentTypeError(f'invalid size: {text}')
+    return int(match.group(1)) * SIZE_SUFFIXES[match.group(2)]
+
+
+def parse_value_types(text):
+    value_types = [value_type.strip() for value_type in text.split(',') if value_type.strip()]
+    for value_type in value_types:
+        if value_type not in VALUE_TYPES:
+            raise argparse.ArgumentTypeError(
+                f'unknown value type: {value_type} (choose from {", ".join(VALUE_TYPES)})')
+    if not value_types:
+        raise argparse.ArgumentTypeError('no value types given')
+    return value_types
+
+
+def parse_rate(text):
+    rate = float(text)
+    if not 0.0 <= rate <= 1.0:
+        raise argparse.ArgumentTypeError(f'rate must be between 0 and 1: {text}')
+    return rate
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generate pcapng captures of serial BAOS traffic over USB '
+                    'for benchmarking the BAOS dissector.')
+    parser.add_argument('output', help='pcapng file to write, or - for stdout')
+    parser.add_argument('--header', action='append', dest='headers',
+                        help='header to take the protocol definitions from, may be given '
+                             'more than once (default: packet-baos.h and ft12.h)')
+    parser.add_argument('--size', type=parse_size, default=0,
+                        help='stop once the file reaches this size, e.g. 500M or 2G')
+    parser.add_argument('--telegrams', type=int, default=0,
+                        help='stop after this many telegrams (default: 10000 if no size is given)')
+    parser.add_argument('--devices', type=int, default=1, help='number of BAOS devices')
+    parser.add_argument('--datapoints', type=int, default=100, help='number of datapoints per device')
+    parser.add_argument('--value-types', type=parse_value_types, default=list(VALUE_TYPES),
+                        help='comma separated value types assigned to the datapoints in turn '
+                             f'({",".join(VALUE_TYPES)})')
+    parser.add_argument('--param-bytes', type=int, default=256, help='number of parameter bytes per device')
+    parser.add_argument('--error-rate', type=parse_rate, default=0.01,
+                        help='share of responses reporting an error and of failed transmissions')
+    parser.add_argument('--corrupt-rate', type=parse_rate, default=0.0,
+                        help='share of frames with a bad checksum, end byte or length')
+    parser.add_argument('--burst-rate', type=parse_rate, default=0.01,
+                        help='chance of a burst of DatapointValue.Ind telegrams per step')
+    parser.add_argument('--burst-length', type=int, default=50,
+                        help='maximum number of indications in a burst')
+    parser.add_argument('--interval', type=int, default=20000,
+                        help='mean gap between telegrams initiated by host or bus [us]')
+    parser.add_argument('--start-time', type=float, default=1700000000.0,
+                        help='timestamp of the first telegram [s since the epoch]')
+    parser.add_argument('--scenario', action='append', dest='scenarios', choices=SCENARIOS,
+                        help='only generate this kind of steady state traffic, may be given '
+                             'more than once (default: a weighted mix of all but write-server-items)')
+    parser.add_argument('--seed', type=int, default=0, help='seed for reproducible captures')
+    args = parser.parse_args()
+
+    if args.devices < 1 or args.datapoints < 1 or args.datapoints > 0xFFFF:
+        parser.error('at least one device with 1 to 65535 datapoints is needed')
+    if args.param_bytes < 0 or args.burst_length < 1 or args.interval < 1:
+        parser.error('parameter bytes, burst length and interval must be positive')
+    if not args.size and not args.telegrams:
+        args.telegrams = 10000
+
+    try:
+        defs = BaosDefinitions(args.headers or DEFAULT_HEADERS)
+    except (OSError, ValueError) as error:
+        sys.exit(f'baos-capture-gen: {error}')
+
+    started = time.monotonic()
+    output = sys.stdout.buffer if args.output == '-' else open(args.output, 'wb')
+    with output:
+        writer = PcapngWriter(output)
+        generator = Generator(args, defs, writer)
+        generator.run()
+    elapsed = time.monotonic() - started
+
+    print(f'{generator.telegrams} telegrams, {writer.size()} bytes in {elapsed:.1f} s',
+          file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()